@@ -4,14 +4,57 @@
 #include "SnapshotManagement/Snapshot.h"
 
 
-BagGenerator::BagGenerator() : generator(static_cast<unsigned int>(std::time(nullptr))) {
+BagGenerator::BagGenerator() : BagGenerator(randomSeed(), randomSeed()) {}
+
+BagGenerator::BagGenerator(const std::uint64_t seed, const std::uint64_t stream, const RngEngine engine) {
+    this->seed(seed, stream, engine);
+}
+
+void BagGenerator::seed(const std::uint64_t seed, const std::uint64_t stream, const RngEngine engine) {
+    seedValue = seed;
+    streamId = stream;
+    engineType = engine;
+
+    if (engineType == RngEngine::MT19937) {
+        std::seed_seq sequence{
+            static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32u),
+            static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32u)
+        };
+        mersenne = std::make_unique<std::mt19937>(sequence);
+    } else {
+        mersenne.reset();
+        pcg.seed(seed, stream);
+    }
+
+    bag.clear();
     nextBag = generateNewBag();
     refillIfEmpty();
 }
 
-BagGenerator& BagGenerator::getInstance() {
-    static BagGenerator instance;
-    return instance;
+std::uint64_t BagGenerator::getSeed() const {
+    return seedValue;
+}
+
+std::uint64_t BagGenerator::getStream() const {
+    return streamId;
+}
+
+RngEngine BagGenerator::getEngine() const {
+    return engineType;
+}
+
+std::uint64_t BagGenerator::randomSeed() {
+    std::random_device device;
+    return (static_cast<std::uint64_t>(device()) << 32u) | device();
+}
+
+std::uint64_t BagGenerator::deriveSeed(const std::uint64_t masterSeed, const std::uint64_t index) {
+    return splitMix64(masterSeed ^ splitMix64(index));
+}
+
+int BagGenerator::getBagPosition() const {
+    const int remaining = static_cast<int>(bag.size()) % 7;
+    return (7 - remaining) % 7;
 }
 
 void BagGenerator::setBag(std::vector<Cell> newBag) {
@@ -30,7 +73,12 @@ std::vector<Cell> BagGenerator::generateNewBag() {
     newBag.push_back(Cell::S);
     newBag.push_back(Cell::Z);
 
-    std::shuffle(newBag.begin(), newBag.end(), generator);
+    for (std::uint32_t i = static_cast<std::uint32_t>(newBag.size()) - 1; i > 0; --i) {
+        const std::uint32_t j = engineType == RngEngine::MT19937
+            ? uniformBelow(*mersenne, i + 1)
+            : uniformBelow(pcg, i + 1);
+        std::swap(newBag[i], newBag[j]);
+    }
     return newBag;
 }
 
@@ -53,10 +101,15 @@ Cell BagGenerator::next() {
 
 
 std::vector<Cell> BagGenerator::peek(const int count) {
-    refillIfEmpty();
-
     std::vector<Cell> preview;
     preview.reserve(count);
+    peek(count, preview);
+    return preview;
+}
+
+void BagGenerator::peek(const int count, std::vector<Cell>& preview) {
+    refillIfEmpty();
+    preview.clear();
 
     const int currentSize = bag.size();
     for (int i = 0; i < count && i < currentSize; ++i) {
@@ -71,6 +124,4 @@ std::vector<Cell> BagGenerator::peek(const int count) {
             preview.push_back(nextBag[nextSize - 1- i]);
         }
     }
-
-    return preview;
 }
\ No newline at end of file
@@ -1,24 +1,45 @@
 #pragma once
+#include <cstdint>
+#include <memory>
 #include <random>
+#include "Pcg32.h"
 #include "../Board/Cell.h"
 
 struct Snapshot;
 
+enum class RngEngine { PCG32, MT19937 };
+
 class BagGenerator {
     std::vector<Cell> bag;
     std::vector<Cell> nextBag;
-    std::mt19937 generator;
 
-    BagGenerator();
-    BagGenerator(const BagGenerator&) = delete;
-    BagGenerator& operator=(const BagGenerator&) = delete;
+    RngEngine engineType = RngEngine::PCG32;
+    Pcg32 pcg;
+    std::unique_ptr<std::mt19937> mersenne;
+    std::uint64_t seedValue = 0;
+    std::uint64_t streamId = 0;
 
     std::vector<Cell> generateNewBag();
     void refillIfEmpty();
 public:
-    static BagGenerator& getInstance();
+    BagGenerator();
+    explicit BagGenerator(std::uint64_t seed, std::uint64_t stream = 0, RngEngine engine = RngEngine::PCG32);
+    BagGenerator(const BagGenerator&) = delete;
+    BagGenerator& operator=(const BagGenerator&) = delete;
+
+    void seed(std::uint64_t seed, std::uint64_t stream = 0, RngEngine engine = RngEngine::PCG32);
+    std::uint64_t getSeed() const;
+    std::uint64_t getStream() const;
+    RngEngine getEngine() const;
+
+    static std::uint64_t randomSeed();
+    static std::uint64_t deriveSeed(std::uint64_t masterSeed, std::uint64_t index);
 
     void setBag(std::vector<Cell> newBag);
     Cell next();
     std::vector<Cell> peek(int count);
+    // Same as peek(count), reusing the caller's storage.
+    void peek(int count, std::vector<Cell>& preview);
+    // Pieces already drawn from the current bag, 0 when a fresh bag starts.
+    int getBagPosition() const;
 };
@@ -1,42 +1,31 @@
 #include "BlockFactory.h"
-#include "../Blocks/IBlock.h"
-#include "../Blocks/OBlock.h"
-#include "../Blocks/TBlock.h"
-#include "../Blocks/LBlock.h"
-#include "../Blocks/JBlock.h"
-#include "../Blocks/SBlock.h"
-#include "../Blocks/ZBlock.h"
 #include "SnapshotManagement/Snapshot.h"
 
-BlockFactory::BlockFactory() : rng(BagGenerator::getInstance()) {};
+void BlockFactory::loadFromSnapshot(const Snapshot& snapshot) {
+    rng.setBag({snapshot.bag.rbegin(), snapshot.bag.rend()});
+}
 
-BlockFactory& BlockFactory::getInstance() {
-    static BlockFactory instance;
-    return instance;
+void BlockFactory::seed(const std::uint64_t seed, const std::uint64_t stream, const RngEngine engine) {
+    rng.seed(seed, stream, engine);
 }
 
-void BlockFactory::loadFromSnapshot(const Snapshot& snapshot) const {
-    rng.setBag(snapshot.bag);
+const BagGenerator& BlockFactory::getGenerator() const {
+    return rng;
 }
 
-std::unique_ptr<Block> BlockFactory::createNextBlock(const Position& spawnPos) const {
+Block BlockFactory::createNextBlock(const Position& spawnPos) {
     const Cell blockType = rng.next();
     return createBlock(blockType, spawnPos);
 }
 
-std::unique_ptr<Block> BlockFactory::createBlock(const Cell blockType, const Position& spawnPos, const Rotation& rotation) {
-    switch (blockType) {
-        case Cell::I: return std::make_unique<IBlock>(spawnPos, rotation);
-        case Cell::O: return std::make_unique<OBlock>(spawnPos, rotation);
-        case Cell::T: return std::make_unique<TBlock>(spawnPos, rotation);
-        case Cell::L: return std::make_unique<LBlock>(spawnPos, rotation);
-        case Cell::J: return std::make_unique<JBlock>(spawnPos, rotation);
-        case Cell::S: return std::make_unique<SBlock>(spawnPos, rotation);
-        case Cell::Z: return std::make_unique<ZBlock>(spawnPos, rotation);
-        default: return nullptr;
-    }
+Block BlockFactory::createBlock(const Cell blockType, const Position& spawnPos, const Rotation& rotation) {
+    return {blockType, spawnPos, rotation};
 }
 
-std::vector<Cell> BlockFactory::peekNext(const int count) const {
+std::vector<Cell> BlockFactory::peekNext(const int count) {
     return rng.peek(count);
 }
+
+void BlockFactory::peekNext(const int count, std::vector<Cell>& preview) {
+    rng.peek(count, preview);
+}
@@ -4,18 +4,19 @@
 #include "../Blocks/Block.h"
 
 class BlockFactory {
-    BagGenerator& rng;
+    BagGenerator rng;
 
-    BlockFactory();
+public:
+    BlockFactory() = default;
     BlockFactory(const BlockFactory&) = delete;
     BlockFactory& operator=(const BlockFactory&) = delete;
 
-public:
-    static BlockFactory& getInstance();
-
-    void loadFromSnapshot(const Snapshot& snapshot) const;
+    void loadFromSnapshot(const Snapshot& snapshot);
+    void seed(std::uint64_t seed, std::uint64_t stream = 0, RngEngine engine = RngEngine::PCG32);
+    const BagGenerator& getGenerator() const;
 
-    std::unique_ptr<Block> createNextBlock(const Position& spawnPos) const;
-    static std::unique_ptr<Block> createBlock(Cell block, const Position& spawnPos = {0, 0}, const Rotation& rotation = Rotation::R0) ;
-    std::vector<Cell> peekNext(int count) const;
+    Block createNextBlock(const Position& spawnPos);
+    static Block createBlock(Cell block, const Position& spawnPos = {0, 0}, const Rotation& rotation = Rotation::R0) ;
+    std::vector<Cell> peekNext(int count);
+    void peekNext(int count, std::vector<Cell>& preview);
 };
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+
+// PCG-XSH-RR 32-bit output, 64-bit state. Each odd increment selects an independent stream.
+class Pcg32 {
+    std::uint64_t state = 0;
+    std::uint64_t increment = 1;
+
+public:
+    using result_type = std::uint32_t;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    explicit Pcg32(const std::uint64_t seedValue = 0x853c49e6748fea9bULL, const std::uint64_t stream = 0) {
+        seed(seedValue, stream);
+    }
+
+    void seed(const std::uint64_t seedValue, const std::uint64_t stream = 0) {
+        state = 0;
+        increment = (stream << 1u) | 1u;
+        (*this)();
+        state += seedValue;
+        (*this)();
+    }
+
+    result_type operator()() {
+        const std::uint64_t oldState = state;
+        state = oldState * 6364136223846793005ULL + increment;
+        const auto xorShifted = static_cast<std::uint32_t>(((oldState >> 18u) ^ oldState) >> 27u);
+        const auto rotation = static_cast<std::uint32_t>(oldState >> 59u);
+        return (xorShifted >> rotation) | (xorShifted << ((0u - rotation) & 31u));
+    }
+};
+
+constexpr std::uint64_t splitMix64(std::uint64_t value) {
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30u)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27u)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31u);
+}
+
+// Unbiased draw in [0, bound) that gives the same sequence on every standard library.
+template <typename Generator>
+std::uint32_t uniformBelow(Generator& generator, const std::uint32_t bound) {
+    const std::uint32_t threshold = (0u - bound) % bound;
+    while (true) {
+        const auto value = static_cast<std::uint32_t>(generator());
+        if (value >= threshold) return value % bound;
+    }
+}
@@ -1,6 +1,6 @@
 #include "Block.h"
 
-Block::Block(const Position p, const Rotation r) : position(p), rotation(r), type(Cell::Empty){}
+Block::Block(const Cell type, const Position p, const Rotation r) : position(p), rotation(r), type(type) {}
 
 Position Block::getPosition() const {
     return position;
@@ -16,7 +16,6 @@ Rotation Block::getRotation() const {
 
 void Block::resetRotation() {
     rotation = Rotation::R0;
-    calculateShape();
 }
 
 Cell Block::getType() const {
@@ -33,7 +32,6 @@ void Block::rotateCW() {
         (static_cast<int>(rotation) + 1) % 4);
 
     this->rotation = newRotation;
-    calculateShape();
 }
 
 void Block::rotateCCW() {
@@ -41,22 +39,29 @@ void Block::rotateCCW() {
         (static_cast<int>(rotation) - 1 + 4) % 4);
 
     this->rotation = newRotation;
-    calculateShape();
 }
 
-std::vector<Position> Block::getGlobalCellsAt(const Position& newPos) const {
-    std::vector<Position> globalPositions;
+const ShapeOffsets& Block::getCells() const {
+    return BLOCK_SHAPES[shapeIndex(type)][static_cast<int>(rotation)];
+}
+
+const ShapeMask& Block::getShapeMask() const {
+    return BLOCK_SHAPE_MASKS[shapeIndex(type)][static_cast<int>(rotation)];
+}
 
-    for (const auto& offset : shapeOffsets) {
-        Position absolutePos = {
-            newPos.x + offset.x,
-            newPos.y + offset.y
-        };
-        globalPositions.push_back(absolutePos);
+ShapeOffsets Block::getGlobalCellsAt(const Position& newPos) const {
+    ShapeOffsets globalPositions = getCells();
+
+    for (auto& cell : globalPositions) {
+        cell.x += newPos.x;
+        cell.y += newPos.y;
     }
     return globalPositions;
 }
 
-std::vector<Position> Block::getSuperRotationOffSets(Rotation from, Rotation to) const{
-    return SuperRotation.at({from, to});
+KickOffsets Block::getSuperRotationOffSets(const Rotation from, const Rotation to) const {
+    if (type == Cell::O || !isKickTransition(from, to)) return {};
+
+    const auto& kicks = (type == Cell::I ? I_WALL_KICK_DATA : JLSTZ_WALL_KICK_DATA)[kickTransitionIndex(from, to)];
+    return {kicks.data(), kicks.data() + kicks.size()};
 }
@@ -1,25 +1,19 @@
 #pragma once
-#include <vector>
-#include <map>
+#include <type_traits>
 #include "../Board/Position.h"
 #include "../Board/Cell.h"
+#include "Rotation.h"
+#include "BlockShapes.h"
+#include "WallKicks.h"
 
-enum class Rotation { R0 = 0, R90 = 1, R180 = 2, R270 = 3 };
-
-class Block {
-protected:
-    Position position;
-    Rotation rotation;
-    std::vector<Position> shapeOffsets;
-    Cell type;
-    std::map<std::pair<Rotation, Rotation>, std::vector<Position>> SuperRotation;
-
-    virtual void calculateShape() = 0;
+class Block final {
+    Position position{0, 0};
+    Rotation rotation = Rotation::R0;
+    Cell type = Cell::Empty;
 
 public:
-    Block(Position p, Rotation r);
-
-    virtual ~Block() = default;
+    Block() = default;
+    Block(Cell type, Position p, Rotation r = Rotation::R0);
 
     void rotateCW();
     void rotateCCW();
@@ -30,34 +24,10 @@ public:
     Rotation getRotation() const;
     void resetRotation();
     Cell getType() const;
-    std::vector<Position> getGlobalCellsAt(const Position& newPos) const;
-    std::vector<Position> getSuperRotationOffSets(Rotation from, Rotation to) const;
+    const ShapeOffsets& getCells() const;
+    const ShapeMask& getShapeMask() const;
+    ShapeOffsets getGlobalCellsAt(const Position& newPos) const;
+    KickOffsets getSuperRotationOffSets(Rotation from, Rotation to) const;
 };
 
-
-static const std::map<std::pair<Rotation, Rotation>, std::vector<Position>> JLSTZ_WALL_KICK_DATA = {
-    { {Rotation::R0, Rotation::R90}, {
-        Position{0, 0}, {-1, 0}, {-1, -1}, {0, +2}, {-1, +2}
-    } },
-    { {Rotation::R90, Rotation::R0}, {
-        Position{0, 0}, {+1, 0}, {+1, +1}, {0, -2}, {+1, -2}
-    } },
-    { {Rotation::R90, Rotation::R180}, {
-        Position{0, 0}, {+1, 0}, {+1, +1}, {0, -2}, {+1, -2}
-    } },
-    { {Rotation::R180, Rotation::R90}, {
-        Position{0, 0}, {-1, 0}, {-1, -1}, {0, +2}, {-1, +2}
-    } },
-    { {Rotation::R180, Rotation::R270}, {
-        Position{0, 0}, {+1, 0}, {+1, -1}, {0, +2}, {+1, +2}
-    } },
-    { {Rotation::R270, Rotation::R180}, {
-        Position{0, 0}, {-1, 0}, {-1, +1}, {0, -2}, {-1, -2}
-    } },
-    { {Rotation::R270, Rotation::R0}, {
-        Position{0, 0}, {-1, 0}, {-1, +1}, {0, -2}, {-1, -2}
-    } },
-    { {Rotation::R0, Rotation::R270}, {
-        Position{0, 0}, {+1, 0}, {+1, -1}, {0, +2}, {+1, +2}
-    } },
-};
\ No newline at end of file
+static_assert(std::is_trivially_copyable_v<Block>);
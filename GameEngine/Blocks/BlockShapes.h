@@ -0,0 +1,94 @@
+#pragma once
+#include <array>
+#include "../Board/Position.h"
+#include "../Board/Cell.h"
+#include "../Board/BitBoard.h"
+
+using ShapeOffsets = std::array<Position, 4>;
+using RotationShapes = std::array<ShapeOffsets, 4>;
+
+static constexpr std::array<RotationShapes, 7> BLOCK_SHAPES = {{
+    // I
+    {{
+        {{ {-1, 0}, {0, 0}, {1, 0}, {2, 0} }},
+        {{ {1, 1}, {1, 0}, {1, -1}, {1, -2} }},
+        {{ {-1, -1}, {0, -1}, {1, -1}, {2, -1} }},
+        {{ {0, 1}, {0, 0}, {0, -1}, {0, -2} }},
+    }},
+    // O
+    {{
+        {{ {0, 0}, {1, 0}, {0, 1}, {1, 1} }},
+        {{ {0, 0}, {1, 0}, {0, 1}, {1, 1} }},
+        {{ {0, 0}, {1, 0}, {0, 1}, {1, 1} }},
+        {{ {0, 0}, {1, 0}, {0, 1}, {1, 1} }},
+    }},
+    // T
+    {{
+        {{ {-1, 0}, {0, 0}, {1, 0}, {0, 1} }},
+        {{ {0, 1}, {0, 0}, {0, -1}, {1, 0} }},
+        {{ {-1, 0}, {0, 0}, {1, 0}, {0, -1} }},
+        {{ {0, 1}, {0, 0}, {0, -1}, {-1, 0} }},
+    }},
+    // L
+    {{
+        {{ {-1, 0}, {0, 0}, {1, 0}, {1, 1} }},
+        {{ {0, 1}, {0, 0}, {0, -1}, {1, -1} }},
+        {{ {-1, 0}, {0, 0}, {1, 0}, {-1, -1} }},
+        {{ {0, 1}, {0, 0}, {0, -1}, {-1, 1} }},
+    }},
+    // J
+    {{
+        {{ {-1, 1}, {-1, 0}, {0, 0}, {1, 0} }},
+        {{ {0, 1}, {1, 1}, {0, 0}, {0, -1} }},
+        {{ {-1, 0}, {0, 0}, {1, 0}, {1, -1} }},
+        {{ {0, 1}, {0, 0}, {0, -1}, {-1, -1} }},
+    }},
+    // S
+    {{
+        {{ {-1, 0}, {0, 0}, {0, 1}, {1, 1} }},
+        {{ {0, 1}, {0, 0}, {1, 0}, {1, -1} }},
+        {{ {0, 0}, {1, 0}, {-1, -1}, {0, -1} }},
+        {{ {-1, 1}, {-1, 0}, {0, 0}, {0, -1} }},
+    }},
+    // Z
+    {{
+        {{ {-1, 1}, {0, 1}, {0, 0}, {1, 0} }},
+        {{ {1, 1}, {0, 0}, {1, 0}, {0, -1} }},
+        {{ {-1, 0}, {0, 0}, {0, -1}, {1, -1} }},
+        {{ {0, 1}, {-1, 0}, {0, 0}, {-1, -1} }},
+    }},
+}};
+
+constexpr int shapeIndex(const Cell type) {
+    return static_cast<int>(type) - static_cast<int>(Cell::I);
+}
+
+constexpr ShapeMask makeShapeMask(const ShapeOffsets& cells) {
+    int minX = cells[0].x, maxX = cells[0].x;
+    int minY = cells[0].y, maxY = cells[0].y;
+    for (const auto& cell : cells) {
+        minX = cell.x < minX ? cell.x : minX;
+        maxX = cell.x > maxX ? cell.x : maxX;
+        minY = cell.y < minY ? cell.y : minY;
+        maxY = cell.y > maxY ? cell.y : maxY;
+    }
+
+    ShapeMask mask{minX, minY, maxX - minX + 1, maxY - minY + 1, {}};
+    for (const auto& cell : cells)
+        mask.rows[cell.y - minY] |= RowMask{1} << (cell.x - minX);
+    return mask;
+}
+
+constexpr std::array<std::array<ShapeMask, 4>, 7> makeShapeMasks() {
+    std::array<std::array<ShapeMask, 4>, 7> masks{};
+    for (int type = 0; type < 7; ++type) {
+        for (int rotation = 0; rotation < 4; ++rotation)
+            masks[type][rotation] = makeShapeMask(BLOCK_SHAPES[type][rotation]);
+    }
+    return masks;
+}
+
+static constexpr std::array<std::array<ShapeMask, 4>, 7> BLOCK_SHAPE_MASKS = makeShapeMasks();
+
+static_assert(BLOCK_SHAPE_MASKS[shapeIndex(Cell::I)][0].rows[0] == 0b1111);
+static_assert(BLOCK_SHAPE_MASKS[shapeIndex(Cell::T)][0].height == 2);
@@ -1,9 +0,0 @@
-#pragma once
-#include "Block.h"
-
-class IBlock final : public Block {
-protected:
-    void calculateShape() override;
-public:
-    IBlock(Position p, Rotation r);
-};
\ No newline at end of file
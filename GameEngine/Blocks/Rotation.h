@@ -0,0 +1,3 @@
+#pragma once
+
+enum class Rotation { R0 = 0, R90 = 1, R180 = 2, R270 = 3 };
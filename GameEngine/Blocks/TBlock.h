@@ -1,9 +0,0 @@
-#pragma once
-#include "Block.h"
-
-class TBlock final : public Block {
-protected:
-    void calculateShape() override;
-public:
-    TBlock(Position p, Rotation r);
-};
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+#include <array>
+#include "../Board/Position.h"
+#include "Rotation.h"
+
+using KickTable = std::array<std::array<Position, 5>, 8>;
+
+class KickOffsets {
+    const Position* first = nullptr;
+    const Position* last = nullptr;
+
+public:
+    constexpr KickOffsets() = default;
+    constexpr KickOffsets(const Position* first, const Position* last) : first(first), last(last) {}
+
+    constexpr const Position* begin() const { return first; }
+    constexpr const Position* end() const { return last; }
+    constexpr int size() const { return static_cast<int>(last - first); }
+    constexpr bool empty() const { return first == last; }
+};
+
+constexpr bool isKickTransition(const Rotation from, const Rotation to) {
+    const int delta = (static_cast<int>(to) - static_cast<int>(from) + 4) % 4;
+    return delta == 1 || delta == 3;
+}
+
+constexpr int kickTransitionIndex(const Rotation from, const Rotation to) {
+    const int fromIndex = static_cast<int>(from);
+    const bool clockwise = static_cast<int>(to) == (fromIndex + 1) % 4;
+    return fromIndex * 2 + (clockwise ? 0 : 1);
+}
+
+static constexpr KickTable JLSTZ_WALL_KICK_DATA = {{
+    // R0 -> R90
+    {{ {0, 0}, {-1, 0}, {-1, -1}, {0, +2}, {-1, +2} }},
+    // R0 -> R270
+    {{ {0, 0}, {+1, 0}, {+1, -1}, {0, +2}, {+1, +2} }},
+    // R90 -> R180
+    {{ {0, 0}, {+1, 0}, {+1, +1}, {0, -2}, {+1, -2} }},
+    // R90 -> R0
+    {{ {0, 0}, {+1, 0}, {+1, +1}, {0, -2}, {+1, -2} }},
+    // R180 -> R270
+    {{ {0, 0}, {+1, 0}, {+1, -1}, {0, +2}, {+1, +2} }},
+    // R180 -> R90
+    {{ {0, 0}, {-1, 0}, {-1, -1}, {0, +2}, {-1, +2} }},
+    // R270 -> R0
+    {{ {0, 0}, {-1, 0}, {-1, +1}, {0, -2}, {-1, -2} }},
+    // R270 -> R180
+    {{ {0, 0}, {-1, 0}, {-1, +1}, {0, -2}, {-1, -2} }},
+}};
+
+static constexpr KickTable I_WALL_KICK_DATA = {{
+    // R0 -> R90
+    {{ {0, 0}, {-2, 0}, {+1, 0}, {-2, +1}, {+1, -2} }},
+    // R0 -> R270
+    {{ {0, 0}, {-1, 0}, {+2, 0}, {-1, -2}, {+2, +1} }},
+    // R90 -> R180
+    {{ {0, 0}, {-1, 0}, {+2, 0}, {-1, -2}, {+2, +1} }},
+    // R90 -> R0
+    {{ {0, 0}, {+2, 0}, {-1, 0}, {+2, -1}, {-1, +2} }},
+    // R180 -> R270
+    {{ {0, 0}, {+2, 0}, {-1, 0}, {+2, -1}, {-1, +2} }},
+    // R180 -> R90
+    {{ {0, 0}, {+1, 0}, {-2, 0}, {+1, +2}, {-2, -1} }},
+    // R270 -> R0
+    {{ {0, 0}, {+1, 0}, {-2, 0}, {+1, +2}, {-2, -1} }},
+    // R270 -> R180
+    {{ {0, 0}, {-2, 0}, {+1, 0}, {-2, +1}, {+1, -2} }},
+}};
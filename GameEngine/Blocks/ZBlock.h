@@ -1,9 +0,0 @@
-#pragma once
-#include "Block.h"
-
-class ZBlock final : public Block {
-protected:
-    void calculateShape() override;
-public:
-    ZBlock(Position p, Rotation r);
-};
@@ -0,0 +1,43 @@
+#include "BitBoard.h"
+#include <cassert>
+
+BitBoard::BitBoard(const int w, const int h) :
+    width(w),
+    height(h),
+    fullRow(w >= MAX_WIDTH ? ~RowMask{0} : (RowMask{1} << w) - 1)
+{
+    assert(w > 0 && w <= MAX_WIDTH);
+    assert(h > 0 && h <= MAX_HEIGHT);
+}
+
+void BitBoard::reset() {
+    rows.fill(0);
+    hash = 0;
+}
+
+RowSet BitBoard::clearFullLines() {
+    int first = 0;
+    while (first < height && rows[first] != fullRow)
+        first++;
+    if (first == height) return 0;
+
+    const int top = getStackHeight();
+    for (int y = first; y < top; ++y)
+        hash ^= rowHash(y, rows[y]);
+
+    RowSet cleared = 0;
+    int writeY = first;
+
+    for (int y = first; y < top; ++y) {
+        if (rows[y] == fullRow) {
+            cleared |= RowSet{1} << y;
+            continue;
+        }
+        hash ^= rowHash(writeY, rows[y]);
+        rows[writeY++] = rows[y];
+    }
+    for (int y = writeY; y < top; ++y)
+        rows[y] = 0;
+
+    return cleared;
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "Position.h"
+#include "Zobrist.h"
+
+using RowMask = std::uint32_t;
+using RowSet = std::uint64_t;
+
+inline int countCells(const std::uint64_t mask) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt64(mask));
+#else
+    return __builtin_popcountll(mask);
+#endif
+}
+
+inline int lowestCell(const std::uint64_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+struct ShapeMask {
+    int minX;
+    int minY;
+    int width;
+    int height;
+    std::array<RowMask, 4> rows;
+};
+
+class BitBoard {
+public:
+    static constexpr int MAX_WIDTH = 32;
+    static constexpr int MAX_HEIGHT = 64;
+
+private:
+    int width;
+    int height;
+    RowMask fullRow;
+    std::array<RowMask, MAX_HEIGHT> rows{};
+    std::uint64_t hash = 0;
+
+    static std::uint64_t rowHash(const int y, RowMask cells) {
+        std::uint64_t rowKey = 0;
+        for (; cells; cells &= cells - 1)
+            rowKey ^= zobrist::cell(lowestCell(cells), y);
+        return rowKey;
+    }
+
+public:
+    BitBoard(int w = 10, int h = 20);
+
+    void reset();
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    RowMask getFullRowMask() const { return fullRow; }
+    // Zobrist hash of the occupied cells, kept up to date by every mutation.
+    std::uint64_t getHash() const { return hash; }
+
+    RowMask getRow(const int y) const { return rows[y]; }
+    void setRow(const int y, const RowMask mask) {
+        hash ^= rowHash(y, rows[y] ^ (mask & fullRow));
+        rows[y] = mask & fullRow;
+    }
+
+    bool isInside(const int x, const int y) const {
+        return x >= 0 && x < width && y >= 0 && y < height;
+    }
+    bool isOccupied(const int x, const int y) const { return (rows[y] >> x) & 1u; }
+    void setCell(const int x, const int y) {
+        if (isOccupied(x, y)) return;
+        rows[y] |= RowMask{1} << x;
+        hash ^= zobrist::cell(x, y);
+    }
+
+    bool isLineFull(const int y) const { return rows[y] == fullRow; }
+
+    // One past the highest row holding any cell.
+    int getStackHeight() const {
+        for (int y = height - 1; y >= 0; --y) {
+            if (rows[y]) return y + 1;
+        }
+        return 0;
+    }
+
+    bool fits(const ShapeMask& shape, const Position& pos) const {
+        const int left = pos.x + shape.minX;
+        const int bottom = pos.y + shape.minY;
+        if (left < 0 || left + shape.width > width || bottom < 0 || bottom + shape.height > height)
+            return false;
+
+        for (int i = 0; i < shape.height; ++i) {
+            if (rows[bottom + i] & (shape.rows[i] << left))
+                return false;
+        }
+        return true;
+    }
+
+    void place(const ShapeMask& shape, const Position& pos) {
+        const int left = pos.x + shape.minX;
+        const int bottom = pos.y + shape.minY;
+        for (int i = 0; i < shape.height; ++i) {
+            const RowMask cells = shape.rows[i] << left;
+            hash ^= rowHash(bottom + i, cells & ~rows[bottom + i]);
+            rows[bottom + i] |= cells;
+        }
+    }
+
+    // Removes every full row, shifting the rows above down. Returns a bit per cleared row index.
+    // Only the rows from the lowest cleared one up are rehashed.
+    RowSet clearFullLines();
+};
+
+static_assert(BitBoard::MAX_WIDTH <= zobrist::MAX_WIDTH && BitBoard::MAX_HEIGHT <= zobrist::MAX_HEIGHT);
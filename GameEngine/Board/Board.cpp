@@ -4,20 +4,18 @@
 Board::Board(const int w, const int h) :
     width(w),
     height(h),
-    grid(h, std::vector<Cell>(w, Cell::Empty))
+    grid(h, std::vector<Cell>(w, Cell::Empty)),
+    occupancy(w, h)
 {};
 
-Board& Board::getInstance(const int w, const int h) {
-    static Board instance(w, h);
-    return instance;
-}
-
 void Board::setGameEngine(GameEngine* gameEngine) {
     this->engine = gameEngine;
 }
 
 void Board::reset() {
     grid = std::vector<std::vector<Cell>>(height, std::vector<Cell>(width, Cell::Empty));
+    occupancy.reset();
+    dirtyRows = ~RowSet{0};
 }
 
 Position Board::getSpawnPosition() const {
@@ -28,96 +26,90 @@ Position Board::getSpawnPosition() const {
 
 void Board::setGrid(const std::vector<std::vector<Cell>>& newGrid) {
     grid = newGrid;
+    dirtyRows = ~RowSet{0};
+
+    occupancy.reset();
+    for (int y = 0; y < height; ++y) {
+        RowMask mask = 0;
+        for (int x = 0; x < width; ++x) {
+            if (grid[y][x] != Cell::Empty)
+                mask |= RowMask{1} << x;
+        }
+        occupancy.setRow(y, mask);
+    }
 }
 
 std::vector<std::vector<Cell>> Board::getGrid() const {
     return grid;
 }
 
-std::vector<std::vector<Cell>> Board::getRenderGrid(const Block* currentBlock) const {
-    auto renderGrid = grid;
-    if (currentBlock) {
-        const auto globalCells = currentBlock->getGlobalCellsAt(currentBlock->getPosition());
-        const Cell type = currentBlock->getType();
-
-        const auto ghostCells = currentBlock->getGlobalCellsAt(getGhostPosition(*currentBlock));
-        const Cell ghostType = ghostMap.at(type);
-        for (const auto& ghostCell : ghostCells) {
-            if (ghostCell.y >= 0 && ghostCell.y < height &&
-                ghostCell.x >= 0 && ghostCell.x < width) {
-                renderGrid[ghostCell.y][ghostCell.x] = ghostType;
-                }
-        }
+const BitBoard& Board::getOccupancy() const {
+    return occupancy;
+}
 
-        for (const auto& cellPos : globalCells) {
-            if (cellPos.y >= 0 && cellPos.y < height &&
-                cellPos.x >= 0 && cellPos.x < width) {
-                    renderGrid[cellPos.y][cellPos.x] = type;
-                }
-        }
-    }
-    return renderGrid;
+std::uint64_t Board::getHash() const {
+    return occupancy.getHash();
+}
+
+const std::vector<Cell>& Board::getRowCells(const int y) const {
+    return grid[y];
+}
+
+RowSet Board::takeDirtyRows() {
+    const RowSet rows = dirtyRows;
+    dirtyRows = 0;
+    return rows;
 }
 
 void Board::placeBlock(const Block& block) {
-    const std::vector<Position> globalCells = block.getGlobalCellsAt(block.getPosition());
+    const auto globalCells = block.getGlobalCellsAt(block.getPosition());
 
     const Cell typeToPlace = block.getType();
 
-    for (const auto& cellPos : globalCells)
+    for (const auto& cellPos : globalCells) {
         grid[cellPos.y][cellPos.x] = typeToPlace;
+        dirtyRows |= RowSet{1} << cellPos.y;
+    }
+
+    occupancy.place(block.getShapeMask(), block.getPosition());
 }
 
 bool Board::isValidPosition(const Block& block, const Position& newPos) const {
-    const std::vector<Position> globalCells = block.getGlobalCellsAt(newPos);
-
-    for (const auto& cellPos : globalCells) {
-        if (cellPos.x < 0 || cellPos.x >= width || cellPos.y >= height || cellPos.y < 0) {
-            return false;
-        }
-
-        if (grid[cellPos.y][cellPos.x] != Cell::Empty) {
-            return false;
-        }
-    }
-
-    return true;
+    return occupancy.fits(block.getShapeMask(), newPos);
 }
 
 int Board::clearFullLines() {
-    int linesClearedCount = 0;
-    for (int y = 0; y < height; ++y) {
-
-        if (isLineFull(y)) {
-            linesClearedCount++;
+    const RowSet cleared = occupancy.clearFullLines();
+    if (!cleared) return 0;
 
-            for (int k = y; k < height - 1; ++k) {
-                grid[k] = grid[k + 1];
-            }
-            grid[height - 1].assign(width, Cell::Empty);
+    // Every row from the lowest cleared one up shifts.
+    dirtyRows |= ~((cleared & (0 - cleared)) - 1);
 
-            y--;
-        }
+    int writeY = 0;
+    for (int y = 0; y < height; ++y) {
+        if (cleared & (RowSet{1} << y)) continue;
+        if (writeY != y)
+            grid[writeY].swap(grid[y]);
+        writeY++;
     }
-    return linesClearedCount;
+    for (int y = writeY; y < height; ++y)
+        grid[y].assign(width, Cell::Empty);
+
+    return height - writeY;
 }
 
 bool Board::isLineFull(const int y) const {
-    for (int x = 0; x < width; ++x) {
-        if (grid[y][x] == Cell::Empty) {
-            return false;
-        }
-    }
-    return true;
+    return occupancy.isLineFull(y);
 }
 
 int Board::getDropDistance(const Block& block) const {
     int distance = 0;
 
+    const ShapeMask& shape = block.getShapeMask();
     auto pos = block.getPosition();
     pos.y--;
 
-    while (isValidPosition(block, pos)) {
+    while (occupancy.fits(shape, pos)) {
         distance++;
         pos.y--;
     }
@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include "Cell.h"
+#include "BitBoard.h"
 #include "../Blocks/Block.h"
 
 class GameEngine;
@@ -9,25 +10,28 @@ class Board final {
     int width;
     int height;
     std::vector<std::vector<Cell>> grid;
+    BitBoard occupancy;
+    RowSet dirtyRows = ~RowSet{0};
 
     GameEngine* engine = nullptr;
 
-    Board(int w, int h);
-    ~Board() = default;
-
     bool isLineFull(int y) const;
 public:
+    Board(int w = 10, int h = 20);
     Board(const Board&) = delete;
     Board& operator=(const Board&) = delete;
-    static Board& getInstance(int w = 10, int h = 20);
     void setGameEngine(GameEngine* gameEngine);
 
     void setGrid(const std::vector<std::vector<Cell>>& newGrid);
     std::vector<std::vector<Cell>> getGrid() const;
+    const BitBoard& getOccupancy() const;
+    std::uint64_t getHash() const;
 
     void reset();
     Position getSpawnPosition() const;
-    std::vector<std::vector<Cell>> getRenderGrid(const Block* currentBlock) const;
+    const std::vector<Cell>& getRowCells(int y) const;
+    // Rows whose cells changed since the previous call.
+    RowSet takeDirtyRows();
     bool isValidPosition(const Block& block, const Position& newPos) const;
     void placeBlock(const Block& block);
     int clearFullLines();
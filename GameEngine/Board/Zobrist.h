@@ -0,0 +1,56 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+#include "Cell.h"
+#include "../BlockFactory/Pcg32.h"
+
+namespace zobrist {
+    constexpr int MAX_WIDTH = 32;
+    constexpr int MAX_HEIGHT = 64;
+    constexpr int PIECE_TYPES = 8;
+    constexpr int BAG_SIZE = 7;
+    constexpr int MAX_QUEUE = 16;
+
+    // Key streams are disjoint index ranges of one splitmix sequence, so every key is distinct.
+    constexpr std::uint64_t key(const std::uint64_t index) {
+        return splitMix64(0x5a0b7157ULL * 0x9e3779b97f4a7c15ULL + index);
+    }
+
+    template <std::size_t N>
+    constexpr std::array<std::uint64_t, N> makeKeys(const std::uint64_t offset) {
+        std::array<std::uint64_t, N> keys{};
+        for (std::size_t i = 0; i < N; ++i)
+            keys[i] = key(offset + i);
+        return keys;
+    }
+
+    constexpr std::uint64_t CELL_OFFSET = 0;
+    constexpr std::uint64_t HOLD_OFFSET = CELL_OFFSET + MAX_WIDTH * MAX_HEIGHT;
+    constexpr std::uint64_t BAG_OFFSET = HOLD_OFFSET + PIECE_TYPES;
+    constexpr std::uint64_t QUEUE_OFFSET = BAG_OFFSET + BAG_SIZE;
+    constexpr std::uint64_t QUEUE_LENGTH_OFFSET = QUEUE_OFFSET + MAX_QUEUE * PIECE_TYPES;
+    constexpr std::uint64_t HELD_OFFSET = QUEUE_LENGTH_OFFSET + MAX_QUEUE + 1;
+
+    // Indexed by y * MAX_WIDTH + x.
+    static constexpr auto CELLS = makeKeys<MAX_WIDTH * MAX_HEIGHT>(CELL_OFFSET);
+    // Indexed by piece type, Cell::Empty included for an empty hold slot.
+    static constexpr auto HOLD = makeKeys<PIECE_TYPES>(HOLD_OFFSET);
+    static constexpr auto BAG_POSITION = makeKeys<BAG_SIZE>(BAG_OFFSET);
+    // Indexed by queue slot * PIECE_TYPES + piece type.
+    static constexpr auto QUEUE = makeKeys<MAX_QUEUE * PIECE_TYPES>(QUEUE_OFFSET);
+    static constexpr auto QUEUE_LENGTH = makeKeys<MAX_QUEUE + 1>(QUEUE_LENGTH_OFFSET);
+    static constexpr std::uint64_t HELD = key(HELD_OFFSET);
+
+    constexpr std::uint64_t cell(const int x, const int y) {
+        return CELLS[y * MAX_WIDTH + x];
+    }
+
+    constexpr std::uint64_t hold(const Cell type) {
+        return HOLD[static_cast<int>(type)];
+    }
+
+    constexpr std::uint64_t queueSlot(const int slot, const Cell type) {
+        return QUEUE[slot * PIECE_TYPES + static_cast<int>(type)];
+    }
+}
@@ -0,0 +1,91 @@
+#include "Bot.h"
+#include <algorithm>
+#include "../GameEngine.h"
+
+void playDecision(GameEngine& engine, const BotDecision& decision) {
+    for (const auto move : decision.path) {
+        switch (move) {
+            case PlacementMove::LEFT: engine.requestMove(-1); break;
+            case PlacementMove::RIGHT: engine.requestMove(1); break;
+            case PlacementMove::ROTATE_CW: engine.requestRotate(true); break;
+            case PlacementMove::ROTATE_CCW: engine.requestRotate(false); break;
+            case PlacementMove::SOFT_DROP: engine.requestSoftDrop(); break;
+        }
+    }
+    engine.requestHardDrop();
+}
+
+Bot::Bot(BotConfig config) : config(config) {
+    this->config.beamWidth = std::max(1, this->config.beamWidth);
+    this->config.previewDepth = std::max(0, this->config.previewDepth);
+    beam.reserve(this->config.beamWidth);
+    children.reserve(this->config.beamWidth * 64);
+}
+
+const BotConfig& Bot::getConfig() const {
+    return config;
+}
+
+void Bot::expand(const BeamNode& node, const std::vector<Placement>& placements, const int root) {
+    for (size_t i = 0; i < placements.size(); ++i) {
+        const Block& block = placements[i].block;
+
+        BeamNode child{node.board, node.reward, 0.0, root < 0 ? static_cast<int>(i) : root};
+        child.board.place(block.getShapeMask(), block.getPosition());
+        child.reward += config.weights.linesCleared * countCells(child.board.clearFullLines());
+        child.score = child.reward + evaluate(child.board, config.weights);
+
+        children.push_back(child);
+    }
+}
+
+void Bot::keepBest() {
+    const auto byScore = [](const BeamNode& a, const BeamNode& b) { return a.score > b.score; };
+    if (static_cast<int>(children.size()) > config.beamWidth) {
+        std::nth_element(children.begin(), children.begin() + config.beamWidth, children.end(), byScore);
+        children.resize(config.beamWidth);
+    }
+    beam.swap(children);
+    children.clear();
+}
+
+std::optional<BotDecision> Bot::decide(const BitBoard& board, const Block& current,
+                                       const std::vector<Cell>& preview, const Position& spawn) {
+    const auto& roots = rootGenerator.generate(board, current);
+    if (roots.empty()) return std::nullopt;
+
+    beam.clear();
+    children.clear();
+    expand({board, 0.0, 0.0, -1}, roots, -1);
+    keepBest();
+
+    const int depth = std::min(config.previewDepth, static_cast<int>(preview.size()));
+    for (int i = 0; i < depth; ++i) {
+        const Block next(preview[i], spawn);
+        for (const auto& node : beam)
+            expand(node, searchGenerator.generate(node.board, next), node.root);
+
+        if (children.empty()) break;
+        keepBest();
+    }
+
+    const auto best = std::max_element(beam.begin(), beam.end(),
+        [](const BeamNode& a, const BeamNode& b) { return a.score < b.score; });
+
+    const Placement& choice = roots[best->root];
+    return BotDecision{choice.block, rootGenerator.pathTo(choice), best->score};
+}
+
+bool Bot::play(GameEngine& engine) {
+    if (engine.getGameState() != GameState::RUNNING) return false;
+
+    const auto current = engine.getCurrentBlock();
+    if (!current) return false;
+
+    const auto decision = decide(engine.getOccupancy(), *current,
+                                 engine.peekNext(config.previewDepth), engine.getSpawnPosition());
+    if (!decision) return false;
+
+    playDecision(engine, *decision);
+    return true;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <optional>
+#include <vector>
+
+#include "Evaluator.h"
+#include "../Search/MoveGenerator.h"
+
+class GameEngine;
+
+struct BotConfig {
+    int beamWidth = 8;
+    int previewDepth = 3;
+    EvaluationWeights weights;
+};
+
+struct BotDecision {
+    Block target;
+    std::vector<PlacementMove> path;
+    double score = 0.0;
+};
+
+// Drives the current piece along the decision's path with requestMove / requestRotate /
+// requestSoftDrop, then hard drops it.
+void playDecision(GameEngine& engine, const BotDecision& decision);
+
+// Beam search over the current piece and the preview queue. Each layer expands every surviving
+// board with all reachable placements and keeps the best beamWidth by heuristic score.
+class Bot {
+    struct BeamNode {
+        BitBoard board;
+        double reward;
+        double score;
+        int root;
+    };
+
+    BotConfig config;
+    MoveGenerator rootGenerator;
+    MoveGenerator searchGenerator;
+    std::vector<BeamNode> beam;
+    std::vector<BeamNode> children;
+
+    void expand(const BeamNode& node, const std::vector<Placement>& placements, int root);
+    void keepBest();
+
+public:
+    explicit Bot(BotConfig config = {});
+
+    const BotConfig& getConfig() const;
+
+    std::optional<BotDecision> decide(const BitBoard& board, const Block& current,
+                                      const std::vector<Cell>& preview, const Position& spawn);
+
+    // Plans and plays the current piece. Returns false when there was nothing to play.
+    bool play(GameEngine& engine);
+};
@@ -0,0 +1,33 @@
+#include "Evaluator.h"
+
+BoardFeatures extractFeatures(const BitBoard& board) {
+    BoardFeatures features;
+
+    const RowMask full = board.getFullRowMask();
+    const RowMask adjacentPairs = full >> 1;
+    const RowMask leftWall = 1;
+    const RowMask rightWall = full ^ (full >> 1);
+
+    RowMask covered = 0;
+    for (int y = board.getStackHeight() - 1; y >= 0; --y) {
+        const RowMask row = board.getRow(y);
+        covered |= row;
+
+        const RowMask open = ~covered & full;
+        const RowMask wells = open & ((covered << 1) | leftWall) & ((covered >> 1) | rightWall);
+
+        features.aggregateHeight += countCells(covered);
+        features.holes += countCells(~row & covered & full);
+        features.bumpiness += countCells((covered ^ (covered >> 1)) & adjacentPairs);
+        features.wellDepth += countCells(wells);
+    }
+    return features;
+}
+
+double evaluate(const BitBoard& board, const EvaluationWeights& weights) {
+    const BoardFeatures features = extractFeatures(board);
+    return weights.aggregateHeight * features.aggregateHeight +
+           weights.holes * features.holes +
+           weights.bumpiness * features.bumpiness +
+           weights.wellDepth * features.wellDepth;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include "../Board/BitBoard.h"
+
+struct BoardFeatures {
+    int aggregateHeight = 0;
+    int holes = 0;
+    int bumpiness = 0;
+    int wellDepth = 0;
+};
+
+struct EvaluationWeights {
+    double aggregateHeight = -0.510066;
+    double holes = -0.35663;
+    double bumpiness = -0.184483;
+    double wellDepth = -0.04;
+    double linesCleared = 0.760666;
+};
+
+// Every feature is computed a whole row at a time: scanning down from the top of the stack, the
+// running OR of the rows marks the cells below each column's surface, so heights, holes, column
+// differences and well cells are each a popcount of one masked row.
+BoardFeatures extractFeatures(const BitBoard& board);
+
+double evaluate(const BitBoard& board, const EvaluationWeights& weights);
@@ -0,0 +1,152 @@
+#include "ParallelSearch.h"
+#include <algorithm>
+#include "../GameEngine.h"
+
+static constexpr double TOP_OUT_VALUE = -1e9;
+
+ParallelSearch::ParallelSearch(SearchConfig config) :
+    config(config),
+    pool(config.threads),
+    table(config.tableSize)
+{
+    this->config.branching = std::clamp(this->config.branching, 1, MAX_BRANCHING);
+    this->config.rootCandidates = std::max(1, this->config.rootCandidates);
+    this->config.previewDepth = std::clamp(this->config.previewDepth, 0, zobrist::MAX_QUEUE);
+}
+
+const SearchConfig& ParallelSearch::getConfig() const {
+    return config;
+}
+
+int ParallelSearch::getThreadCount() const {
+    return pool.getThreadCount();
+}
+
+SearchStats ParallelSearch::getStats() const {
+    return {nodes.load(), tableHits.load()};
+}
+
+int ParallelSearch::selectChildren(const BitBoard& board, const std::vector<Placement>& placements,
+                                   Child* best, const int limit) const {
+    int count = 0;
+    for (const auto& placement : placements) {
+        BitBoard next = board;
+        next.place(placement.block.getShapeMask(), placement.block.getPosition());
+        const double reward = config.weights.linesCleared * countCells(next.clearFullLines());
+        const double score = reward + evaluate(next, config.weights);
+
+        if (count == limit && score <= best[limit - 1].score) continue;
+
+        int slot = count < limit ? count++ : limit - 1;
+        for (; slot > 0 && best[slot - 1].score < score; --slot)
+            best[slot] = best[slot - 1];
+        best[slot] = {next, reward, score};
+    }
+    return count;
+}
+
+double ParallelSearch::searchNode(const BitBoard& board, const int index) {
+    nodes.fetch_add(1, std::memory_order_relaxed);
+
+    const std::uint64_t key = board.getHash() ^ queueKeys[index];
+    if (const auto cached = table.probe(key)) {
+        tableHits.fetch_add(1, std::memory_order_relaxed);
+        return *cached;
+    }
+
+    thread_local MoveGenerator generator;
+    const auto& placements = generator.generate(board, Block(preview[index], spawn));
+
+    Child children[MAX_BRANCHING];
+    const int count = selectChildren(board, placements, children, config.branching);
+
+    double values[MAX_BRANCHING];
+    const bool leaves = index + 1 == depth;
+    if (leaves) {
+        for (int i = 0; i < count; ++i)
+            values[i] = children[i].score;
+    } else if (depth - index - 1 > config.serialDepth) {
+        WorkStealingPool::TaskGroup group;
+        for (int i = 0; i < count; ++i)
+            pool.submit(group, [&, i] { values[i] = children[i].reward + searchNode(children[i].board, index + 1); });
+        pool.wait(group);
+    } else {
+        for (int i = 0; i < count; ++i)
+            values[i] = children[i].reward + searchNode(children[i].board, index + 1);
+    }
+
+    double value = TOP_OUT_VALUE;
+    for (int i = 0; i < count; ++i)
+        value = std::max(value, values[i]);
+
+    table.store(key, value);
+    return value;
+}
+
+std::optional<BotDecision> ParallelSearch::decide(const BitBoard& board, const Block& current,
+                                                  const std::vector<Cell>& nextPieces, const Position& spawnPosition) {
+    const auto& roots = rootGenerator.generate(board, current);
+    if (roots.empty()) return std::nullopt;
+
+    preview.assign(nextPieces.begin(), nextPieces.begin() + std::min<size_t>(config.previewDepth, nextPieces.size()));
+    spawn = spawnPosition;
+    depth = static_cast<int>(preview.size());
+
+    for (int i = 0; i <= depth; ++i) {
+        queueKeys[i] = zobrist::QUEUE_LENGTH[depth - i];
+        for (int j = i; j < depth; ++j)
+            queueKeys[i] ^= zobrist::queueSlot(j - i, preview[j]);
+    }
+
+    struct Candidate {
+        Child child;
+        int placement;
+        double value;
+    };
+
+    std::vector<Candidate> candidates;
+    candidates.reserve(roots.size());
+    for (size_t i = 0; i < roots.size(); ++i) {
+        BitBoard next = board;
+        next.place(roots[i].block.getShapeMask(), roots[i].block.getPosition());
+        const double reward = config.weights.linesCleared * countCells(next.clearFullLines());
+        const double score = reward + evaluate(next, config.weights);
+        candidates.push_back({{next, reward, score}, static_cast<int>(i), score});
+    }
+
+    const auto byScore = [](const Candidate& a, const Candidate& b) { return a.child.score > b.child.score; };
+    if (static_cast<int>(candidates.size()) > config.rootCandidates) {
+        std::partial_sort(candidates.begin(), candidates.begin() + config.rootCandidates, candidates.end(), byScore);
+        candidates.resize(config.rootCandidates);
+    }
+
+    if (depth > 0) {
+        WorkStealingPool::TaskGroup group;
+        for (auto& candidate : candidates) {
+            pool.submit(group, [this, &candidate] {
+                candidate.value = candidate.child.reward + searchNode(candidate.child.board, 0);
+            });
+        }
+        pool.wait(group);
+    }
+
+    const auto best = std::max_element(candidates.begin(), candidates.end(),
+        [](const Candidate& a, const Candidate& b) { return a.value < b.value; });
+
+    const Placement& choice = roots[best->placement];
+    return BotDecision{choice.block, rootGenerator.pathTo(choice), best->value};
+}
+
+bool ParallelSearch::play(GameEngine& engine) {
+    if (engine.getGameState() != GameState::RUNNING) return false;
+
+    const auto current = engine.getCurrentBlock();
+    if (!current) return false;
+
+    const auto decision = decide(engine.getOccupancy(), *current,
+                                 engine.peekNext(config.previewDepth), engine.getSpawnPosition());
+    if (!decision) return false;
+
+    playDecision(engine, *decision);
+    return true;
+}
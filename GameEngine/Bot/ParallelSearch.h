@@ -0,0 +1,73 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Bot.h"
+#include "../Search/TranspositionTable.h"
+#include "../Search/WorkStealingPool.h"
+
+struct SearchConfig {
+    // Each search owns its pool, so callers running many searches at once keep this at 1.
+    // 0 uses every hardware thread.
+    int threads = 1;
+    int previewDepth = 5;
+    int rootCandidates = 8;
+    int branching = 3;
+    // Subtrees with at most this many pieces left are searched on the thread that reached them.
+    int serialDepth = 2;
+    size_t tableSize = 1 << 18;
+    EvaluationWeights weights;
+};
+
+struct SearchStats {
+    std::uint64_t nodes = 0;
+    std::uint64_t tableHits = 0;
+};
+
+// Depth-first tree search over the preview queue. Each node keeps its best few placements by
+// heuristic score and searches them as forked tasks on a work-stealing pool, so every worker
+// explores its own copy of the board. Node values are shared between threads through a
+// lock-free transposition table keyed by board and remaining queue.
+class ParallelSearch {
+    static constexpr int MAX_BRANCHING = 8;
+
+    struct Child {
+        BitBoard board;
+        double reward;
+        double score;
+    };
+
+    SearchConfig config;
+    WorkStealingPool pool;
+    TranspositionTable table;
+    MoveGenerator rootGenerator;
+
+    std::vector<Cell> preview;
+    Position spawn{0, 0};
+    int depth = 0;
+    // Zobrist keys of the pieces still to come from each depth, so table entries stay valid
+    // across moves as the preview shifts.
+    std::array<std::uint64_t, zobrist::MAX_QUEUE + 1> queueKeys{};
+
+    std::atomic<std::uint64_t> nodes{0};
+    std::atomic<std::uint64_t> tableHits{0};
+
+    int selectChildren(const BitBoard& board, const std::vector<Placement>& placements,
+                       Child* best, int limit) const;
+    double searchNode(const BitBoard& board, int index);
+
+public:
+    explicit ParallelSearch(SearchConfig config = {});
+
+    const SearchConfig& getConfig() const;
+    int getThreadCount() const;
+    SearchStats getStats() const;
+
+    std::optional<BotDecision> decide(const BitBoard& board, const Block& current,
+                                      const std::vector<Cell>& preview, const Position& spawn);
+
+    bool play(GameEngine& engine);
+};
@@ -2,11 +2,10 @@
 #include "Command.h"
 
 class HardDropCommand final : public Command {
+public:
     HardDropCommand() = default;
     HardDropCommand(const HardDropCommand&) = delete;
     HardDropCommand& operator=(const HardDropCommand&) = delete;
-public:
-    static HardDropCommand& getInstance();
 
     void execute() override;
 };
\ No newline at end of file
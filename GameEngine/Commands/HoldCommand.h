@@ -2,11 +2,10 @@
 #include "Command.h"
 
 class HoldCommand final : public Command {
+public:
     HoldCommand() = default;
     HoldCommand(const HoldCommand&) = delete;
     HoldCommand& operator=(const HoldCommand&) = delete;
-public:
-    static HoldCommand& getInstance();
 
     void execute() override;
 };
\ No newline at end of file
@@ -2,11 +2,10 @@
 #include "Command.h"
 
 class LoadCommand final : public Command {
+public:
     LoadCommand() = default;
     LoadCommand(const LoadCommand&) = delete;
     LoadCommand& operator=(const LoadCommand&) = delete;
-public:
-    static LoadCommand& getInstance();
 
     void execute() override;
 };
\ No newline at end of file
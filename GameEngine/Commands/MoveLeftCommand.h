@@ -2,11 +2,10 @@
 #include "Command.h"
 
 class MoveLeftCommand final : public Command {
+public:
     MoveLeftCommand() = default;
     MoveLeftCommand(const MoveLeftCommand&) = delete;
     MoveLeftCommand& operator=(const MoveLeftCommand&) = delete;
-public:
-    static MoveLeftCommand& getInstance();
 
     void execute() override;
 };
\ No newline at end of file
@@ -2,11 +2,10 @@
 #include "Commands/Command.h"
 
 class MoveRightCommand final : public Command {
+public:
     MoveRightCommand() = default;
     MoveRightCommand(const MoveRightCommand&) = delete;
     MoveRightCommand& operator=(const MoveRightCommand&) = delete;
-public:
-    static MoveRightCommand& getInstance();
 
     void execute() override;
 };
\ No newline at end of file
@@ -2,11 +2,10 @@
 #include "Command.h"
 
 class PauseCommand final : public Command {
+public:
     PauseCommand() = default;
     PauseCommand(const PauseCommand&) = delete;
     PauseCommand& operator=(const PauseCommand&) = delete;
-public:
-    static PauseCommand& getInstance();
 
     void execute() override;
 };
\ No newline at end of file
@@ -2,11 +2,10 @@
 #include "Command.h"
 
 class ResumeCommand final : public Command {
+public:
     ResumeCommand() = default;
     ResumeCommand(const ResumeCommand&) = delete;
     ResumeCommand& operator=(const ResumeCommand&) = delete;
-public:
-    static ResumeCommand& getInstance();
 
     void execute() override;
 };
\ No newline at end of file
@@ -2,11 +2,10 @@
 #include "Command.h"
 
 class RotateCCWCommand final : public Command {
+public:
     RotateCCWCommand() = default;
     RotateCCWCommand(const RotateCCWCommand&) = delete;
     RotateCCWCommand& operator=(const RotateCCWCommand&) = delete;
-public:
-    static RotateCCWCommand& getInstance();
 
     void execute() override;
 };
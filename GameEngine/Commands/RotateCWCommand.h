@@ -2,11 +2,10 @@
 #include "Command.h"
 
 class RotateCWCommand final : public Command {
+public:
     RotateCWCommand() = default;
     RotateCWCommand(const RotateCWCommand&) = delete;
     RotateCWCommand& operator=(const RotateCWCommand&) = delete;
-public:
-    static RotateCWCommand& getInstance();
 
     void execute() override;
 };
@@ -2,11 +2,10 @@
 #include "Command.h"
 
 class SaveCommand final : public Command {
+public:
     SaveCommand() = default;
     SaveCommand(const SaveCommand&) = delete;
     SaveCommand& operator=(const SaveCommand&) = delete;
-public:
-    static SaveCommand& getInstance();
 
     void execute() override;
 };
\ No newline at end of file
@@ -1,10 +1,5 @@
 #include "SoftDropCommand.h"
 
-SoftDropCommand& SoftDropCommand::getInstance() {
-    static SoftDropCommand instance;
-    return instance;
-}
-
 void SoftDropCommand::execute() {
     if (engine) {
         engine->requestSoftDrop();
@@ -2,11 +2,10 @@
 #include "Command.h"
 
 class SoftDropCommand final : public Command {
+public:
     SoftDropCommand() = default;
     SoftDropCommand(const SoftDropCommand&) = delete;
     SoftDropCommand& operator=(const SoftDropCommand&) = delete;
-public:
-    static SoftDropCommand& getInstance();
 
     void execute() override;
 };
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "BatchEnvironment.h"
+#include <algorithm>
+#include "../GameEngine.h"
+
+static constexpr int GAMES_PER_TASK = 16;
+
+BatchEnvironment::BatchEnvironment(BatchEnvConfig config) : config(config) {
+    const int games = std::max(1, config.games);
+    this->config.games = games;
+
+    engines.reserve(games);
+    for (int i = 0; i < games; ++i) {
+        engines.push_back(std::make_unique<GameEngine>(config.boardWidth, config.boardHeight));
+        engines.back()->setClockMode(ClockMode::FIXED_STEP);
+    }
+    lastScores.assign(games, 0);
+    episodes.assign(games, 0);
+
+    if (config.threads > 1)
+        pool = std::make_unique<WorkStealingPool>(config.threads);
+
+    observation.lockedPlanes.assign(static_cast<size_t>(games) * config.boardHeight, 0);
+    observation.piecePlanes.assign(static_cast<size_t>(games) * config.boardHeight, 0);
+    observation.currentPiece.assign(games, 0);
+    observation.holdPiece.assign(games, 0);
+    observation.canHold.assign(games, 0);
+    observation.preview.assign(static_cast<size_t>(games) * config.previewCount, 0);
+    rewards.assign(games, 0.0f);
+    dones.assign(games, 0);
+
+    reset();
+}
+
+BatchEnvironment::~BatchEnvironment() = default;
+
+const BatchEnvConfig& BatchEnvironment::getConfig() const {
+    return config;
+}
+
+int BatchEnvironment::size() const {
+    return config.games;
+}
+
+void BatchEnvironment::startEpisode(const int game) {
+    GameEngine& engine = *engines[game];
+    engine.seed(BagGenerator::deriveSeed(config.seed, episodes[game]++), game);
+    engine.startNewGame(config.startLevel);
+    lastScores[game] = 0;
+}
+
+void BatchEnvironment::reset() {
+    std::vector<Cell> scratch;
+    for (int game = 0; game < config.games; ++game) {
+        episodes[game] = 0;
+        startEpisode(game);
+        observe(game, scratch);
+    }
+    std::fill(rewards.begin(), rewards.end(), 0.0f);
+    std::fill(dones.begin(), dones.end(), 0);
+}
+
+void BatchEnvironment::observe(const int game, std::vector<Cell>& scratch) {
+    GameEngine& engine = *engines[game];
+    const int height = config.boardHeight;
+
+    const BitBoard occupancy = engine.getOccupancy();
+    RowMask* locked = &observation.lockedPlanes[static_cast<size_t>(game) * height];
+    RowMask* piece = &observation.piecePlanes[static_cast<size_t>(game) * height];
+    for (int y = 0; y < height; ++y) {
+        locked[y] = occupancy.getRow(y);
+        piece[y] = 0;
+    }
+
+    const auto current = engine.getCurrentBlock();
+    if (current) {
+        for (const auto& cell : current->getGlobalCellsAt(current->getPosition())) {
+            if (occupancy.isInside(cell.x, cell.y))
+                piece[cell.y] |= RowMask{1} << cell.x;
+        }
+    }
+
+    observation.currentPiece[game] = static_cast<std::uint8_t>(current ? current->getType() : Cell::Empty);
+    observation.holdPiece[game] = static_cast<std::uint8_t>(engine.getHoldType());
+    observation.canHold[game] = engine.canHold() ? 1 : 0;
+
+    engine.peekNext(config.previewCount, scratch);
+    std::uint8_t* preview = &observation.preview[static_cast<size_t>(game) * config.previewCount];
+    for (int i = 0; i < config.previewCount; ++i)
+        preview[i] = static_cast<std::uint8_t>(i < static_cast<int>(scratch.size()) ? scratch[i] : Cell::Empty);
+}
+
+void BatchEnvironment::stepRange(const std::uint8_t* actions, const int first, const int last) {
+    std::vector<Cell> scratch;
+    scratch.reserve(config.previewCount);
+
+    for (int game = first; game < last; ++game) {
+        GameEngine& engine = *engines[game];
+
+        switch (static_cast<EnvAction>(actions[game])) {
+            case EnvAction::LEFT: engine.executeUnlocked(EngineCommandType::MOVE, -1); break;
+            case EnvAction::RIGHT: engine.executeUnlocked(EngineCommandType::MOVE, 1); break;
+            case EnvAction::ROTATE_CW: engine.executeUnlocked(EngineCommandType::ROTATE, 1); break;
+            case EnvAction::ROTATE_CCW: engine.executeUnlocked(EngineCommandType::ROTATE, 0); break;
+            case EnvAction::SOFT_DROP: engine.executeUnlocked(EngineCommandType::SOFT_DROP); break;
+            case EnvAction::HARD_DROP: engine.executeUnlocked(EngineCommandType::HARD_DROP); break;
+            case EnvAction::HOLD: engine.executeUnlocked(EngineCommandType::HOLD); break;
+            default: break;
+        }
+        engine.advanceFramesUnlocked(config.framesPerStep);
+
+        const long long score = engine.getScoreManager().getScore();
+        rewards[game] = static_cast<float>(score - lastScores[game]);
+        lastScores[game] = score;
+
+        const bool done = engine.getGameState() == GameState::GAME_OVER;
+        dones[game] = done ? 1 : 0;
+        if (done)
+            startEpisode(game);
+
+        observe(game, scratch);
+    }
+}
+
+void BatchEnvironment::step(const std::uint8_t* actions) {
+    if (!pool) {
+        stepRange(actions, 0, config.games);
+        return;
+    }
+
+    WorkStealingPool::TaskGroup group;
+    for (int first = 0; first < config.games; first += GAMES_PER_TASK) {
+        const int last = std::min(first + GAMES_PER_TASK, config.games);
+        pool->submit(group, [this, actions, first, last] { stepRange(actions, first, last); });
+    }
+    pool->wait(group);
+}
+
+const BatchObservation& BatchEnvironment::getObservation() const {
+    return observation;
+}
+
+const std::vector<float>& BatchEnvironment::getRewards() const {
+    return rewards;
+}
+
+const std::vector<std::uint8_t>& BatchEnvironment::getDones() const {
+    return dones;
+}
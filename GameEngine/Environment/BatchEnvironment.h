@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../Board/BitBoard.h"
+#include "../Search/WorkStealingPool.h"
+
+class GameEngine;
+
+enum class EnvAction : std::uint8_t { NONE, LEFT, RIGHT, ROTATE_CW, ROTATE_CCW, SOFT_DROP, HARD_DROP, HOLD, COUNT };
+
+struct BatchEnvConfig {
+    int games = 64;
+    int boardWidth = 10;
+    int boardHeight = 20;
+    int previewCount = 5;
+    int framesPerStep = 1;
+    int startLevel = 1;
+    std::uint64_t seed = 1;
+    int threads = 1;
+};
+
+// Struct-of-arrays observation buffers. Each array is contiguous and indexed by game first, so a
+// game's board occupies boardHeight consecutive row masks with bit x set for column x.
+struct BatchObservation {
+    std::vector<RowMask> lockedPlanes;
+    std::vector<RowMask> piecePlanes;
+    std::vector<std::uint8_t> currentPiece;
+    std::vector<std::uint8_t> holdPiece;
+    std::vector<std::uint8_t> canHold;
+    // previewCount entries per game.
+    std::vector<std::uint8_t> preview;
+};
+
+// Steps many independent fixed-step engines with one call. Each engine is only touched by the task
+// stepping it, so actions run through the engine's unlocked command path (same commands as the
+// request methods, no mutex or queue) and no frames are published for them. Rewards are score deltas from ScoreManager, so the rules and scoring match
+// regular play. A finished game reports done and is restarted on a new seed in the same step.
+class BatchEnvironment {
+    BatchEnvConfig config;
+    std::vector<std::unique_ptr<GameEngine>> engines;
+    std::vector<long long> lastScores;
+    std::vector<std::uint64_t> episodes;
+    std::unique_ptr<WorkStealingPool> pool;
+
+    BatchObservation observation;
+    std::vector<float> rewards;
+    std::vector<std::uint8_t> dones;
+
+    void startEpisode(int game);
+    void stepRange(const std::uint8_t* actions, int first, int last);
+    void observe(int game, std::vector<Cell>& scratch);
+
+public:
+    explicit BatchEnvironment(BatchEnvConfig config = {});
+    ~BatchEnvironment();
+    BatchEnvironment(const BatchEnvironment&) = delete;
+    BatchEnvironment& operator=(const BatchEnvironment&) = delete;
+
+    const BatchEnvConfig& getConfig() const;
+    int size() const;
+
+    void reset();
+    // actions holds one EnvAction value per game.
+    void step(const std::uint8_t* actions);
+
+    const BatchObservation& getObservation() const;
+    const std::vector<float>& getRewards() const;
+    const std::vector<std::uint8_t>& getDones() const;
+};
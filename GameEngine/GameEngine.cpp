@@ -1,27 +1,18 @@
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <stdexcept>
 
 #include "GameEngine.h"
-#include "Board/Board.h"
-#include "ScoreManagement/ScoreManager.h"
-#include "InputHandler.h"
-#include "BlockFactory/BlockFactory.h"
-#include "Blocks/Block.h"
-#include "Timer.h"
 #include "SnapshotManagement/Snapshot.h"
-#include "SnapshotManagement/StorageManager.h"
 
-GameEngine::GameEngine(const int boardWidth, const int boardHeight, InputHandler& input_handler, ScoreManager& score_manager) :
+GameEngine::GameEngine(const int boardWidth, const int boardHeight, Leaderboard* leaderboard) :
     boardWidth(boardWidth),
     boardHeight(boardHeight),
-    board(Board::getInstance(boardWidth, boardHeight)),
-    scoreManager(score_manager),
-    storageManager(StorageManager::getInstance()),
-    inputHandler(input_handler),
-    blockFactory(BlockFactory::getInstance()),
-    holdBlock(nullptr),
-    currentBlock(nullptr),
-    tickTimer(Timer::getInstance()),
-    gameState(GameState::IDLE)
+    board(boardWidth, boardHeight),
+    scoreManager(leaderboard),
+    gameState(GameState::IDLE),
+    checkpoints(boardWidth, boardHeight)
 {
     board.setGameEngine(this);
     scoreManager.setGameEngine(this);
@@ -30,64 +21,308 @@ GameEngine::GameEngine(const int boardWidth, const int boardHeight, InputHandler
     tickTimer.setGameEngine(this);
 }
 
-GameEngine& GameEngine::getInstance(const int boardWidth, const int boardHeight, InputHandler& input_handler, ScoreManager& score_manager) {
-    static GameEngine instance(boardWidth, boardHeight, input_handler, score_manager);
-    return instance;
-}
-
 void GameEngine::setObserver(std::shared_ptr<IObserver> obs) {
     std::lock_guard lock(gameMutex);
     this->observer = std::move(obs);
+    if (this->observer.lock() && !publishing) {
+        publishing = true;
+        publishFrame();
+    }
+}
+
+InputHandler& GameEngine::getInputHandler() {
+    return inputHandler;
+}
+
+ScoreManager& GameEngine::getScoreManager() {
+    return scoreManager;
 }
 
 void GameEngine::notifyObserver() {
-    std::lock_guard lock(gameMutex);
-    if (observer) {
-        observer->onStateChanged();
+    if (publishing.load(std::memory_order_relaxed)) publishFrame();
+    if (const auto obs = observer.lock()) {
+        obs->onStateChanged();
     }
 }
 
 GameEngine::~GameEngine() {
-    std::lock_guard lock(gameMutex);
+    // No gameMutex here: a timer callback may be waiting on it, and we wait for the callbacks.
+    if (scheduler) {
+        scheduler->cancelAndWait(gravityTimer);
+        scheduler->cancelAndWait(lockTimer);
+    }
     tickTimer.stop();
 }
 
-void GameEngine::reset() {
+void CommandLatency::record(const std::chrono::nanoseconds latency) {
+    commands++;
+    total += latency;
+    max = std::max(max, latency);
+
+    const auto micros = static_cast<std::uint64_t>(std::max<long long>(latency.count() / 1000, 0));
+    size_t bucket = 0;
+    while (bucket + 1 < buckets.size() && micros >> bucket) bucket++;
+    buckets[bucket]++;
+}
+
+void GameEngine::setDispatchMode(const DispatchMode mode) {
+    std::lock_guard lock(gameMutex);
+    dispatchMode = mode;
+    if (mode == DispatchMode::DIRECT) drainCommands();
+}
+
+DispatchMode GameEngine::getDispatchMode() const {
+    return dispatchMode.load();
+}
+
+int GameEngine::processCommands() {
     std::lock_guard lock(gameMutex);
+    return drainCommands();
+}
+
+CommandLatency GameEngine::getCommandLatency() const {
+    std::lock_guard lock(gameMutex);
+    return latency;
+}
+
+void GameEngine::dispatch(const EngineCommandType type, const int argument) {
+    if (dispatchMode.load(std::memory_order_relaxed) == DispatchMode::QUEUED) {
+        commands.push({type, argument, std::chrono::steady_clock::now()});
+        return;
+    }
+
+    std::lock_guard lock(gameMutex);
+    execute({type, argument, {}});
+}
+
+int GameEngine::drainCommands() {
+    int processed = 0;
+    for (EngineCommand command; commands.pop(command); processed++) {
+        latency.record(std::chrono::steady_clock::now() - command.postedAt);
+        execute(command);
+    }
+    return processed;
+}
+
+void GameEngine::execute(const EngineCommand& command) {
+    sampleClock();
+    if (recording) recordCommand(command);
+
+    switch (command.type) {
+        case EngineCommandType::RESET: applyReset(); break;
+        case EngineCommandType::START_NEW_GAME: applyStartNewGame(command.argument); break;
+        case EngineCommandType::START_GAME: applyStartGame(); break;
+        case EngineCommandType::PAUSE: applyPause(); break;
+        case EngineCommandType::RESUME: applyResume(); break;
+        case EngineCommandType::TICK: applyTick(std::max(command.argument, 1)); break;
+        case EngineCommandType::LOCK: applyLock(); break;
+        case EngineCommandType::MOVE: applyMove(command.argument); break;
+        case EngineCommandType::ROTATE: applyRotate(command.argument != 0); break;
+        case EngineCommandType::HARD_DROP: applyHardDrop(); break;
+        case EngineCommandType::SOFT_DROP: applySoftDrop(); break;
+        case EngineCommandType::HOLD: applyHold(); break;
+        case EngineCommandType::SAVE: applySave(); break;
+        case EngineCommandType::LOAD: applyLoad(); break;
+        case EngineCommandType::ADVANCE: applyAdvanceTime(std::chrono::microseconds(command.argument)); break;
+    }
+}
+
+void GameEngine::reset() {
+    dispatch(EngineCommandType::RESET);
+}
+
+void GameEngine::applyReset() {
     scoreManager.reset();
     board.reset();
     gameState = GameState::IDLE;
-    holdBlock = nullptr;
-    currentBlock = nullptr;
+    holdBlock.reset();
+    currentBlock.reset();
     hasHeldThisTurn = false;
-    tickTimer.stop();
+    piecesPlaced = 0;
+    stopGravity();
 }
 
 
 void GameEngine::startNewGame(const int level) {
-    std::lock_guard lock(gameMutex);
-    reset();
+    dispatch(EngineCommandType::START_NEW_GAME, level);
+}
+
+void GameEngine::applyStartNewGame(const int level) {
+    applyReset();
     scoreManager.setLevel(level);
     gameState = GameState::RUNNING;
 
-    currentBlock = nullptr;
-    holdBlock = nullptr;
+    currentBlock.reset();
+    holdBlock.reset();
     hasHeldThisTurn = false;
 
     spawnNextBlock();
-
-    const int startLevel = scoreManager.getLevel();
-    const int startInterval = calculateGravityInterval(startLevel);
-    tickTimer.start(startInterval);
+    restartCheckpoints();
+    startGravity();
 }
 
 void GameEngine::startGame() {
-    std::lock_guard lock(gameMutex);
+    dispatch(EngineCommandType::START_GAME);
+}
+
+void GameEngine::applyStartGame() {
     gameState = GameState::RUNNING;
+    startGravity();
+}
+
+void GameEngine::startGravity() {
+    gravityElapsed = std::chrono::microseconds::zero();
+    if (clockMode != ClockMode::REAL_TIME) return;
+
+    const auto interval = calculateGravityPeriod(scoreManager.getLevel());
+    if (!scheduler) {
+        tickTimer.start(interval);
+        return;
+    }
+
+    scheduler->cancel(gravityTimer);
+    gravityTimer = scheduler->scheduleAfter(interval, [this] { tick(); }, interval);
+}
+
+// Runs under gameMutex, so it must not wait for a tick that may itself be waiting on the lock.
+void GameEngine::stopGravity() {
+    if (!scheduler) {
+        tickTimer.requestStop();
+        return;
+    }
+    scheduler->cancel(gravityTimer);
+    scheduler->cancel(lockTimer);
+    gravityTimer = lockTimer = {};
+}
+
+void GameEngine::armLockDeadline() {
+    if (!scheduler || clockMode != ClockMode::REAL_TIME) return;
+
+    scheduler->cancel(lockTimer);
+    lockTimer = scheduler->schedule(lockTimeStart + LOCK_DELAY, [this] { dispatch(EngineCommandType::LOCK); });
+}
+
+void GameEngine::setScheduler(TimerWheel* wheel) {
+    std::lock_guard lock(gameMutex);
+    if (wheel == scheduler) return;
+
+    stopGravity();
+    scheduler = wheel;
+    if (gameState == GameState::RUNNING) startGravity();
+}
+
+void GameEngine::sampleClock() {
+    if (clockMode == ClockMode::REAL_TIME)
+        commandTime = std::chrono::floor<std::chrono::microseconds>(std::chrono::steady_clock::now());
+}
+
+std::chrono::steady_clock::time_point GameEngine::now() const {
+    if (clockMode == ClockMode::FIXED_STEP)
+        return std::chrono::steady_clock::time_point(logicalTime);
+    return commandTime;
+}
+
+void GameEngine::seed(const std::uint64_t seed, const std::uint64_t stream, const RngEngine engine) {
+    std::lock_guard lock(gameMutex);
+    finishRecording();
+    blockFactory.seed(seed, stream, engine);
+}
+
+std::uint64_t GameEngine::getSeed() const {
+    std::lock_guard lock(gameMutex);
+    return blockFactory.getGenerator().getSeed();
+}
 
-    const int startLevel = scoreManager.getLevel();
-    const int startInterval = calculateGravityInterval(startLevel);
-    tickTimer.start(startInterval);
+std::uint64_t GameEngine::getSeedStream() const {
+    std::lock_guard lock(gameMutex);
+    return blockFactory.getGenerator().getStream();
+}
+
+void GameEngine::setClockMode(const ClockMode mode) {
+    std::lock_guard lock(gameMutex);
+    if (clockMode == mode) return;
+
+    finishRecording();
+    clockMode = mode;
+    if (clockMode == ClockMode::FIXED_STEP) {
+        stopGravity();
+    } else if (gameState == GameState::RUNNING) {
+        startGravity();
+    }
+    gravityElapsed = std::chrono::microseconds::zero();
+    isSoftLocked = false;
+}
+
+ClockMode GameEngine::getClockMode() const {
+    std::lock_guard lock(gameMutex);
+    return clockMode;
+}
+
+void GameEngine::advanceTime(const std::chrono::microseconds duration) {
+    std::lock_guard lock(gameMutex);
+    advanceBy(duration);
+}
+
+// Goes through execute() so replays see it, in steps that fit the command's int argument.
+void GameEngine::advanceBy(std::chrono::microseconds duration) {
+    constexpr std::chrono::microseconds MAX_STEP{std::numeric_limits<int>::max()};
+    while (duration > std::chrono::microseconds::zero()) {
+        const auto step = std::min(duration, MAX_STEP);
+        execute({EngineCommandType::ADVANCE, static_cast<int>(step.count()), {}});
+        duration -= step;
+    }
+}
+
+void GameEngine::applyAdvanceTime(const std::chrono::microseconds duration) {
+    if (clockMode != ClockMode::FIXED_STEP) return;
+
+    auto remaining = duration;
+    while (remaining > std::chrono::microseconds::zero()) {
+        if (gameState != GameState::RUNNING) {
+            logicalTime += remaining;
+            return;
+        }
+
+        // A level up can shorten the interval below the time already elapsed; the overdue tick
+        // then happens now, as with Timer::setInterval, instead of moving the clock backwards.
+        const std::chrono::microseconds interval = calculateGravityPeriod(scoreManager.getLevel());
+        const auto untilTick = std::max(interval - gravityElapsed, std::chrono::microseconds::zero());
+        if (remaining < untilTick) {
+            logicalTime += remaining;
+            gravityElapsed += remaining;
+            return;
+        }
+
+        logicalTime += untilTick;
+        remaining -= untilTick;
+        gravityElapsed = std::chrono::microseconds::zero();
+        applyTick(1);
+    }
+}
+
+void GameEngine::advanceFrames(const int frames) {
+    std::lock_guard lock(gameMutex);
+    applyAdvanceFrames(frames);
+}
+
+void GameEngine::advanceFramesUnlocked(const int frames) {
+    applyAdvanceFrames(frames);
+}
+
+void GameEngine::executeUnlocked(const EngineCommandType type, const int argument) {
+    execute({type, argument, {}});
+}
+
+void GameEngine::applyAdvanceFrames(const int frames) {
+    const long long before = elapsedFrames * 1000000 / FRAMES_PER_SECOND;
+    elapsedFrames += frames;
+    const long long after = elapsedFrames * 1000000 / FRAMES_PER_SECOND;
+    advanceBy(std::chrono::microseconds(after - before));
+}
+
+std::chrono::microseconds GameEngine::getLogicalTime() const {
+    std::lock_guard lock(gameMutex);
+    return logicalTime;
 }
 
 GameState GameEngine::getGameState() const {
@@ -98,6 +333,58 @@ std::pair<int, int> GameEngine::getBoardSize() const {
     return std::make_pair(boardWidth, boardHeight);
 }
 
+int GameEngine::getPiecesPlaced() const {
+    std::lock_guard lock(gameMutex);
+    return piecesPlaced;
+}
+
+std::optional<Block> GameEngine::getCurrentBlock() const {
+    std::lock_guard lock(gameMutex);
+    return currentBlock;
+}
+
+std::vector<Cell> GameEngine::peekNext(const int count) {
+    std::lock_guard lock(gameMutex);
+    return blockFactory.peekNext(count);
+}
+
+void GameEngine::peekNext(const int count, std::vector<Cell>& preview) {
+    std::lock_guard lock(gameMutex);
+    blockFactory.peekNext(count, preview);
+}
+
+Cell GameEngine::getHoldType() const {
+    std::lock_guard lock(gameMutex);
+    return holdBlock ? holdBlock->getType() : Cell::Empty;
+}
+
+bool GameEngine::canHold() const {
+    std::lock_guard lock(gameMutex);
+    return currentBlock && !hasHeldThisTurn;
+}
+
+Position GameEngine::getSpawnPosition() const {
+    return board.getSpawnPosition();
+}
+
+std::uint64_t GameEngine::getStateHash() const {
+    std::lock_guard lock(gameMutex);
+    return captureStateHash();
+}
+
+std::uint64_t GameEngine::captureStateHash() const {
+    std::uint64_t hash = board.getHash();
+    hash ^= zobrist::hold(holdBlock ? holdBlock->getType() : Cell::Empty);
+    hash ^= zobrist::BAG_POSITION[blockFactory.getGenerator().getBagPosition()];
+    if (hasHeldThisTurn) hash ^= zobrist::HELD;
+    return hash;
+}
+
+BitBoard GameEngine::getOccupancy() const {
+    std::lock_guard lock(gameMutex);
+    return board.getOccupancy();
+}
+
 void GameEngine::spawnNextBlock() {
     if (gameState != GameState::RUNNING) return;
     hasHeldThisTurn = false;
@@ -106,56 +393,206 @@ void GameEngine::spawnNextBlock() {
     currentBlock = blockFactory.createNextBlock(spawnPosition);
     if (!board.isValidPosition(*currentBlock, spawnPosition)) {
         gameState = GameState::GAME_OVER;
-        std::thread([this]{ tickTimer.stop(); }).detach();
+        stopGravity();
     }
     isSoftLocked = false;
     notifyObserver();
 }
 
-const RenderData& GameEngine::getRenderData() {
-    std::lock_guard lock(gameMutex);
+int GameEngine::collectOverlay(std::array<OverlayCell, 8>& cells) {
+    if (!currentBlock) return 0;
+
+    const std::uint64_t key = board.getHash() ^ splitMix64(
+        static_cast<std::uint64_t>(static_cast<std::uint32_t>(currentBlock->getPosition().x)) |
+        static_cast<std::uint64_t>(static_cast<std::uint32_t>(currentBlock->getPosition().y)) << 16 |
+        static_cast<std::uint64_t>(currentBlock->getRotation()) << 32 |
+        static_cast<std::uint64_t>(currentBlock->getType()) << 40);
+    if (key != ghostKey) {
+        ghostKey = key;
+        ghostPosition = board.getGhostPosition(*currentBlock);
+    }
+
+    int count = 0;
+    const Cell ghostType = ghostMap.at(currentBlock->getType());
+    for (const auto& cell : currentBlock->getGlobalCellsAt(ghostPosition))
+        cells[count++] = {cell, ghostType};
+    for (const auto& cell : currentBlock->getGlobalCellsAt(currentBlock->getPosition()))
+        cells[count++] = {cell, currentBlock->getType()};
+    return count;
+}
+
+bool GameEngine::composeRenderState() {
+    bool changed = false;
+    if (renderState.cells.empty()) {
+        renderState.width = boardWidth;
+        renderState.height = boardHeight;
+        renderState.cells.assign(static_cast<size_t>(boardWidth) * boardHeight, Cell::Empty);
+        renderState.nextTypes.reserve(peekNextN);
+        changed = true;
+    }
+
+    const RowSet allRows = boardHeight >= 64 ? ~RowSet{0} : (RowSet{1} << boardHeight) - 1;
+    RowSet dirty = board.takeDirtyRows() & allRows;
+
+    std::array<OverlayCell, 8> current{};
+    const int currentCount = collectOverlay(current);
+    const auto sameOverlay = [&] {
+        if (currentCount != overlayCount) return false;
+        for (int i = 0; i < currentCount; ++i) {
+            if (current[i].position.x != overlay[i].position.x || current[i].position.y != overlay[i].position.y ||
+                current[i].type != overlay[i].type)
+                return false;
+        }
+        return true;
+    };
+
+    if (!sameOverlay()) {
+        for (int i = 0; i < overlayCount; ++i)
+            dirty |= RowSet{1} << overlay[i].position.y;
+        for (int i = 0; i < currentCount; ++i)
+            dirty |= RowSet{1} << current[i].position.y;
+        overlay = current;
+        overlayCount = currentCount;
+    }
+    dirty &= allRows;
 
-    cachedRenderData.grid = board.getRenderGrid(currentBlock.get());
-    cachedRenderData.holdType = holdBlock ? holdBlock->getType() : Cell::Empty;
-    cachedRenderData.nextTypes = blockFactory.peekNext(peekNextN);
-    cachedRenderData.score = scoreManager.getScore();
-    cachedRenderData.level = scoreManager.getLevel();
-    cachedRenderData.totalLinesCleared = scoreManager.getTotalLinesCleared();
-    cachedRenderData.gameState = gameState.load();
+    for (RowSet rows = dirty; rows; rows &= rows - 1) {
+        const int y = lowestCell(rows);
+        const auto& row = board.getRowCells(y);
+        std::copy(row.begin(), row.end(), renderState.cells.begin() + static_cast<size_t>(y) * boardWidth);
+    }
+    for (int i = 0; i < overlayCount; ++i) {
+        const Position& cell = overlay[i].position;
+        if ((dirty >> cell.y & 1) && cell.x >= 0 && cell.x < boardWidth && cell.y >= 0 && cell.y < boardHeight)
+            renderState.cells[static_cast<size_t>(cell.y) * boardWidth + cell.x] = overlay[i].type;
+    }
 
-    return cachedRenderData;
+    const Cell holdType = holdBlock ? holdBlock->getType() : Cell::Empty;
+    const long long score = scoreManager.getScore();
+    const int level = scoreManager.getLevel();
+    const int lines = scoreManager.getTotalLinesCleared();
+    const GameState state = gameState.load();
+    changed = changed || dirty || holdType != renderState.holdType || score != renderState.score ||
+              level != renderState.level || lines != renderState.totalLinesCleared || state != renderState.gameState;
+
+    nextScratch.swap(renderState.nextTypes);
+    blockFactory.peekNext(peekNextN, renderState.nextTypes);
+    changed = changed || nextScratch != renderState.nextTypes;
+
+    renderState.dirtyRows = dirty;
+    renderState.holdType = holdType;
+    renderState.score = score;
+    renderState.level = level;
+    renderState.totalLinesCleared = lines;
+    renderState.gameState = state;
+    return changed;
 }
 
-void GameEngine::tick() {
-    std::lock_guard lock(gameMutex);
+void GameEngine::publishFrame() {
+    if (!composeRenderState()) return;
+
+    renderState.generation++;
+    for (auto& rows : staleRows)
+        rows |= renderState.dirtyRows;
+
+    RenderData& frame = frames.writeBuffer();
+    RowSet& stale = staleRows[frames.writeIndex()];
+    if (frame.cells.size() != renderState.cells.size()) {
+        frame.cells.resize(renderState.cells.size());
+        stale = ~RowSet{0};
+    }
+
+    const RowSet allRows = boardHeight >= 64 ? ~RowSet{0} : (RowSet{1} << boardHeight) - 1;
+    for (RowSet rows = stale & allRows; rows; rows &= rows - 1) {
+        const auto rowStart = static_cast<size_t>(lowestCell(rows)) * boardWidth;
+        std::copy_n(renderState.cells.begin() + rowStart, boardWidth, frame.cells.begin() + rowStart);
+    }
+    stale = 0;
+
+    frame.width = renderState.width;
+    frame.height = renderState.height;
+    frame.dirtyRows = renderState.dirtyRows;
+    frame.generation = renderState.generation;
+    frame.holdType = renderState.holdType;
+    frame.nextTypes = renderState.nextTypes;
+    frame.score = renderState.score;
+    frame.level = renderState.level;
+    frame.totalLinesCleared = renderState.totalLinesCleared;
+    frame.gameState = renderState.gameState;
+
+    frames.publish();
+}
+
+const RenderData& GameEngine::getRenderData() {
+    if (!publishing.load()) {
+        std::lock_guard lock(gameMutex);
+        if (!publishing) {
+            publishing = true;
+            publishFrame();
+        }
+    }
+    return frames.read();
+}
+
+void GameEngine::tick(const int rows) {
+    dispatch(EngineCommandType::TICK, rows);
+}
+
+void GameEngine::applyTick(const int rows) {
     if (gameState.load() != GameState::RUNNING) return;
     if (!currentBlock) return;
 
     Position pos = currentBlock->getPosition();
-    pos.y--;
-
-    if (board.isValidPosition(*currentBlock, pos)) {
-        currentBlock->move(0, -1);
-    } else if (!isSoftLocked) {
-        isSoftLocked = true;
-        lockTimeStart = std::chrono::steady_clock::now();
-        lockResetCount = 0;
-    } else {
-         auto elapsed = std::chrono::steady_clock::now() - lockTimeStart;
-        if (elapsed >= LOCK_DELAY) {
-
-            board.placeBlock(*currentBlock);
-            scoreManager.addLineClear(board.clearFullLines());
+    int fallen = 0;
+    while (fallen < rows && board.isValidPosition(*currentBlock, {pos.x, pos.y - 1})) {
+        pos.y--;
+        fallen++;
+    }
 
-            spawnNextBlock();
+    if (fallen > 0) {
+        currentBlock->move(0, -fallen);
+    }
 
+    if (fallen < rows) {
+        if (!isSoftLocked) {
+            isSoftLocked = true;
+            lockTimeStart = now();
+            lockResetCount = 0;
+            armLockDeadline();
+        } else if (now() - lockTimeStart >= LOCK_DELAY) {
+            lockCurrentBlock();
         }
     }
     notifyObserver();
 }
 
+void GameEngine::applyLock() {
+    if (gameState.load() != GameState::RUNNING) return;
+    if (!currentBlock || !isSoftLocked) return;
+    if (now() - lockTimeStart < LOCK_DELAY) return;
+
+    Position pos = currentBlock->getPosition();
+    pos.y--;
+    if (board.isValidPosition(*currentBlock, pos)) return;
+
+    lockCurrentBlock();
+    notifyObserver();
+}
+
+void GameEngine::lockCurrentBlock() {
+    board.placeBlock(*currentBlock);
+    piecesPlaced++;
+    scoreManager.addLineClear(board.clearFullLines());
+
+    spawnNextBlock();
+    recordCheckpoint();
+}
+
 void GameEngine::requestMove(const int dx) {
-    std::lock_guard lock(gameMutex);
+    dispatch(EngineCommandType::MOVE, dx);
+}
+
+void GameEngine::applyMove(const int dx) {
     if (gameState != GameState::RUNNING) return;
     if (!currentBlock) return;
 
@@ -166,15 +603,19 @@ void GameEngine::requestMove(const int dx) {
         currentBlock->move(dx, 0);
 
         if (isSoftLocked && lockResetCount < MAX_LOCK_RESETS) {
-            lockTimeStart = std::chrono::steady_clock::now();
+            lockTimeStart = now();
             lockResetCount++;
+            armLockDeadline();
         }
     }
     notifyObserver();
 }
 
 void GameEngine::requestRotate(const bool clockwise) {
-    std::lock_guard lock(gameMutex);
+    dispatch(EngineCommandType::ROTATE, clockwise ? 1 : 0);
+}
+
+void GameEngine::applyRotate(const bool clockwise) {
     if (gameState != GameState::RUNNING) return;
     if (!currentBlock) return;
 
@@ -192,8 +633,9 @@ void GameEngine::requestRotate(const bool clockwise) {
         notifyObserver();
 
         if (isSoftLocked && lockResetCount < MAX_LOCK_RESETS) {
-            lockTimeStart = std::chrono::steady_clock::now();
+            lockTimeStart = now();
             lockResetCount++;
+            armLockDeadline();
         }
         return;
     }
@@ -205,8 +647,9 @@ void GameEngine::requestRotate(const bool clockwise) {
             notifyObserver();
 
             if (isSoftLocked && lockResetCount < MAX_LOCK_RESETS) {
-                lockTimeStart = std::chrono::steady_clock::now();
+                lockTimeStart = now();
                 lockResetCount++;
+                armLockDeadline();
             }
             return;
         }
@@ -220,27 +663,29 @@ void GameEngine::requestRotate(const bool clockwise) {
 
 
 void GameEngine::requestHardDrop() {
-    std::lock_guard lock(gameMutex);
+    dispatch(EngineCommandType::HARD_DROP);
+}
+
+void GameEngine::applyHardDrop() {
     if (gameState != GameState::RUNNING) return;
     if (!currentBlock) return;
 
+    // A piece already resting on the stack (after a tuck or a spin) still locks in place.
     const int dropDistance = board.getDropDistance(*currentBlock);
-
     if (dropDistance > 0) {
         currentBlock->move(0, -dropDistance);
-
         scoreManager.addHardDropPoints(dropDistance);
-
-        board.placeBlock(*currentBlock);
-
-        scoreManager.addLineClear(board.clearFullLines());
-        spawnNextBlock();
-        notifyObserver();
     }
+
+    lockCurrentBlock();
+    notifyObserver();
 }
 
 void GameEngine::requestSoftDrop() {
-    std::lock_guard lock(gameMutex);
+    dispatch(EngineCommandType::SOFT_DROP);
+}
+
+void GameEngine::applySoftDrop() {
     if (gameState != GameState::RUNNING) return;
     if (!currentBlock) return;
 
@@ -255,83 +700,131 @@ void GameEngine::requestSoftDrop() {
 }
 
 void GameEngine::pause() {
-    std::lock_guard lock(gameMutex);
+    dispatch(EngineCommandType::PAUSE);
+}
+
+void GameEngine::applyPause() {
     if (gameState == GameState::RUNNING) {
-        tickTimer.stop();
+        stopGravity();
         gameState = GameState::PAUSED;
         notifyObserver();
     }
 }
 
 void GameEngine::resume() {
-    std::lock_guard lock(gameMutex);
+    dispatch(EngineCommandType::RESUME);
+}
+
+void GameEngine::applyResume() {
     if (gameState == GameState::PAUSED) {
         gameState = GameState::RUNNING;
-
-        const int level = scoreManager.getLevel();
-        const int currentInterval = calculateGravityInterval(level);
-        tickTimer.start(currentInterval);
+        startGravity();
         notifyObserver();
     }
 }
 
 void GameEngine::requestHold() {
-    std::lock_guard lock(gameMutex);
+    dispatch(EngineCommandType::HOLD);
+}
+
+void GameEngine::applyHold() {
     if (gameState != GameState::RUNNING) return;
     if (!currentBlock || hasHeldThisTurn) return;
     hasHeldThisTurn = true;
 
     if (!holdBlock) {
-        holdBlock = std::move(currentBlock);
+        holdBlock = currentBlock;
         holdBlock->resetRotation();
         spawnNextBlock();
     } else {
-        std::unique_ptr<Block> tempBlock = std::move(currentBlock);
-        currentBlock = std::move(holdBlock);
+        std::swap(currentBlock, holdBlock);
 
         const Position spawnPos = board.getSpawnPosition();
         currentBlock->setPosition(spawnPos);
 
-        holdBlock = std::move(tempBlock);
         holdBlock->resetRotation();
     }
     notifyObserver();
 }
 
-void GameEngine::requestSave() const {
-    std::lock_guard lock(gameMutex);
+void GameEngine::requestSave() {
+    dispatch(EngineCommandType::SAVE);
+}
+
+void GameEngine::applySave() {
     if (gameState.load() != GameState::IDLE && gameState.load() != GameState::PAUSED) return;
 
-    storageManager.saveGame();
+    storageManager.saveGame(captureSnapshot());
 }
 
 void GameEngine::requestLoad() {
-    std::lock_guard lock(gameMutex);
+    dispatch(EngineCommandType::LOAD);
+}
 
+void GameEngine::applyLoad() {
     if (const std::unique_ptr<Snapshot> loadedState = storageManager.loadGame()) {
-        restoreFromSnapshot(*loadedState);
+        finishRecording();
+        applySnapshot(*loadedState);
+        restartCheckpoints();
         gameState = GameState::LOADED;
     }
 
 }
 
+bool GameEngine::saveToSlot(const std::string& slot) {
+    if (slot.empty() || slot.size() > SaveStore::MAX_NAME_LENGTH) return false;
+
+    std::lock_guard lock(gameMutex);
+    if (gameState.load() != GameState::IDLE && gameState.load() != GameState::PAUSED) return false;
+
+    storageManager.saveGame(captureSnapshot(), slot);
+    return true;
+}
+
+bool GameEngine::loadFromSlot(const std::string& slot) {
+    std::lock_guard lock(gameMutex);
+    const std::unique_ptr<Snapshot> loadedState = storageManager.loadGame(slot);
+    if (!loadedState) return false;
+
+    finishRecording();
+    applySnapshot(*loadedState);
+    restartCheckpoints();
+    gameState = GameState::LOADED;
+    return true;
+}
+
+std::vector<SaveSlotInfo> GameEngine::listSaveSlots() {
+    return storageManager.listSlots();
+}
+
 int GameEngine::calculateGravityInterval(const int level) {
     auto interval = static_cast<int>(1000 * pow((0.8 - (level - 1.0) / 250.0), level - 1));
     if (interval <= 0) return 1;
     return interval;
 }
 
-void GameEngine::updateLevelSpeed() const {
-    std::lock_guard lock(gameMutex);
+std::chrono::microseconds GameEngine::calculateGravityPeriod(const int level) {
+    const auto period = std::llround(1000000 * pow((0.8 - (level - 1.0) / 250.0), level - 1));
+    return std::chrono::microseconds(std::max(period, 1LL));
+}
+
+void GameEngine::updateLevelSpeed() {
     if (gameState != GameState::RUNNING) return;
+    if (clockMode != ClockMode::REAL_TIME) return;
 
-    const int level = scoreManager.getLevel();
-    const int newInterval = calculateGravityInterval(level);
+    const auto period = calculateGravityPeriod(scoreManager.getLevel());
+    if (scheduler)
+        scheduler->setPeriod(gravityTimer, period);
+    else
+        tickTimer.setInterval(period);
+}
 
-    tickTimer.setInterval(newInterval);
+Snapshot GameEngine::createSnapshot() {
+    std::lock_guard lock(gameMutex);
+    return captureSnapshot();
 }
 
-Snapshot GameEngine::createSnapshot() const {
+Snapshot GameEngine::captureSnapshot() {
     Snapshot snapshot{};
 
     snapshot.grid = board.getGrid();
@@ -357,7 +850,14 @@ Snapshot GameEngine::createSnapshot() const {
 }
 
 void GameEngine::restoreFromSnapshot(const Snapshot& snapshot) {
-    reset();
+    std::lock_guard lock(gameMutex);
+    finishRecording();
+    applySnapshot(snapshot);
+    restartCheckpoints();
+}
+
+void GameEngine::applySnapshot(const Snapshot& snapshot) {
+    applyReset();
 
     board.setGrid(snapshot.grid);
     scoreManager.restoreFromSnapshot(snapshot);
@@ -378,4 +878,147 @@ void GameEngine::restoreFromSnapshot(const Snapshot& snapshot) {
 
     blockFactory.loadFromSnapshot(snapshot);
     notifyObserver();
-}
\ No newline at end of file
+}
+
+void GameEngine::recordCheckpoint() {
+    if (!checkpointing) return;
+
+    Snapshot& snapshot = checkpointScratch;
+    snapshot.grid.resize(boardHeight);
+    for (int y = 0; y < boardHeight; ++y)
+        snapshot.grid[y] = board.getRowCells(y);
+    snapshot.score = scoreManager.getScore();
+    snapshot.level = scoreManager.getLevel();
+    snapshot.totalLinesCleared = scoreManager.getTotalLinesCleared();
+
+    snapshot.currentBlockType = currentBlock ? currentBlock->getType() : Cell::Empty;
+    snapshot.currentBlockPosition = currentBlock ? currentBlock->getPosition() : Position{0, 0};
+    snapshot.currentBlockRotation = currentBlock ? currentBlock->getRotation() : Rotation::R0;
+    snapshot.holdBlockType = holdBlock ? holdBlock->getType() : Cell::Empty;
+    blockFactory.peekNext(7, snapshot.bag);
+
+    checkpoints.append(snapshot);
+}
+
+void GameEngine::restartCheckpoints() {
+    checkpoints.clear();
+    recordCheckpoint();
+}
+
+void GameEngine::setCheckpointing(const bool enabled) {
+    std::lock_guard lock(gameMutex);
+    checkpointing = enabled;
+    restartCheckpoints();
+}
+
+bool GameEngine::isCheckpointing() const {
+    std::lock_guard lock(gameMutex);
+    return checkpointing;
+}
+
+size_t GameEngine::getCheckpointCount() const {
+    std::lock_guard lock(gameMutex);
+    return checkpoints.size();
+}
+
+Snapshot GameEngine::getCheckpoint(const size_t index) const {
+    std::lock_guard lock(gameMutex);
+    return checkpoints.get(index);
+}
+
+size_t GameEngine::getCheckpointMemoryUsage() const {
+    std::lock_guard lock(gameMutex);
+    return checkpoints.getMemoryUsage();
+}
+
+bool GameEngine::rewindTo(const size_t index) {
+    std::lock_guard lock(gameMutex);
+    return applyRewind(index);
+}
+
+bool GameEngine::undoPiece() {
+    std::lock_guard lock(gameMutex);
+    return checkpoints.size() >= 2 && applyRewind(checkpoints.size() - 2);
+}
+
+bool GameEngine::applyRewind(const size_t index) {
+    if (index >= checkpoints.size()) return false;
+
+    finishRecording();
+    checkpoints.get(index, checkpointScratch);
+    applySnapshot(checkpointScratch);
+    checkpoints.truncate(index + 1);
+    gameState = GameState::PAUSED;
+    return true;
+}
+
+void GameEngine::startRecording() {
+    std::lock_guard lock(gameMutex);
+    const BagGenerator& generator = blockFactory.getGenerator();
+    const std::uint64_t seed = generator.getSeed(), stream = generator.getStream();
+    const RngEngine engine = generator.getEngine();
+    blockFactory.seed(seed, stream, engine);
+
+    recorder.start(boardWidth, boardHeight, seed, stream, engine);
+    sampleClock();
+    recordingStart = now();
+    recording = true;
+}
+
+Replay GameEngine::stopRecording() {
+    std::lock_guard lock(gameMutex);
+    finishRecording();
+    return recorder.take();
+}
+
+bool GameEngine::isRecording() const {
+    std::lock_guard lock(gameMutex);
+    return recording;
+}
+
+// Saves and loads touch files rather than game state, and real-time ADVANCE commands do nothing,
+// so none of them are recorded.
+void GameEngine::recordCommand(const EngineCommand& command) {
+    if (command.type == EngineCommandType::SAVE || command.type == EngineCommandType::LOAD) return;
+    if (command.type == EngineCommandType::ADVANCE && clockMode == ClockMode::REAL_TIME) return;
+
+    recorder.record({command.type, command.argument,
+                     std::chrono::duration_cast<std::chrono::microseconds>(now() - recordingStart)});
+}
+
+void GameEngine::finishRecording() {
+    if (!recording) return;
+
+    recorder.getReplay().outcome = captureOutcome();
+    recording = false;
+}
+
+ReplayOutcome GameEngine::captureOutcome() const {
+    return {scoreManager.getScore(), scoreManager.getLevel(), scoreManager.getTotalLinesCleared(),
+            piecesPlaced, captureStateHash()};
+}
+
+// Every event runs at its recorded time on the logical clock, and gravity comes from the
+// recorded TICK and ADVANCE commands, so the engine's own timers never fire.
+ReplayOutcome GameEngine::playReplay(const Replay& replay) {
+    std::lock_guard lock(gameMutex);
+    if (replay.boardWidth != boardWidth || replay.boardHeight != boardHeight)
+        throw std::invalid_argument("Replay board size does not match the engine");
+
+    finishRecording();
+    stopGravity();
+    clockMode = ClockMode::FIXED_STEP;
+    applyReset();
+    blockFactory.seed(replay.seed, replay.stream, replay.rngEngine);
+    logicalTime = gravityElapsed = std::chrono::microseconds::zero();
+    elapsedFrames = 0;
+    isSoftLocked = false;
+    lockResetCount = 0;
+
+    ReplayEvent event{};
+    for (ReplayReader reader(replay); reader.next(event);) {
+        logicalTime = event.time;
+        execute({event.type, event.argument, {}});
+    }
+    return captureOutcome();
+}
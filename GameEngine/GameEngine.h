@@ -1,47 +1,101 @@
 #pragma once
+#include <array>
+#include <atomic>
 #include <vector>
 #include <memory>
+#include <optional>
 #include <mutex>
 #include <chrono>
 #include "Board/Cell.h"
+#include "Board/Board.h"
+#include "Blocks/Block.h"
+#include "BlockFactory/BlockFactory.h"
+#include "ScoreManagement/ScoreManager.h"
+#include "SnapshotManagement/StorageManager.h"
+#include "SnapshotManagement/CheckpointLog.h"
+#include "Replay/Replay.h"
+#include "InputHandler.h"
+#include "Timer.h"
+#include "TimerWheel.h"
+#include "TripleBuffer.h"
+#include "MpscQueue.h"
 #include "IObserver.h"
 
-struct Snapshot;
-class Board;
-class ScoreManager;
-class StorageManager;
-class InputHandler;
-class BlockFactory;
-class Block;
-class Timer;
-struct Position;
-
 enum class GameState { IDLE, LOADED, RUNNING, PAUSED, GAME_OVER };
+enum class ClockMode { REAL_TIME, FIXED_STEP };
+enum class DispatchMode { DIRECT, QUEUED };
+
+enum class EngineCommandType : std::uint8_t {
+    RESET, START_NEW_GAME, START_GAME, PAUSE, RESUME, TICK, LOCK,
+    MOVE, ROTATE, HARD_DROP, SOFT_DROP, HOLD, SAVE, LOAD, ADVANCE
+};
+
+struct EngineCommand {
+    EngineCommandType type = EngineCommandType::TICK;
+    int argument = 0;
+    std::chrono::steady_clock::time_point postedAt;
+};
+
+// Time queued commands waited before the owning thread ran them. buckets[i] counts commands that
+// waited less than 2^i microseconds; the last bucket also takes everything slower.
+struct CommandLatency {
+    std::uint64_t commands = 0;
+    std::chrono::nanoseconds total{0};
+    std::chrono::nanoseconds max{0};
+    std::array<std::uint64_t, 20> buckets{};
 
+    void record(std::chrono::nanoseconds latency);
+};
+
+// Board, ghost and active piece composed into one flat row-major buffer, cell (x, y) at
+// y * width + x with y = 0 at the bottom. Every published frame bumps generation by one, and
+// dirtyRows lists the rows that differ from the previous published frame; a reader that sees
+// generation jump by more than one skipped frames and should treat every row as dirty.
 struct RenderData {
-    std::vector<std::vector<Cell>> grid;
+    int width = 0;
+    int height = 0;
+    std::vector<Cell> cells;
+    RowSet dirtyRows = 0;
+    std::uint64_t generation = 0;
+
     Cell holdType = Cell::Empty;
     std::vector<Cell> nextTypes;
     long long score = 0;
     int level = 1;
     int totalLinesCleared = 0;
     GameState gameState = GameState::IDLE;
+
+    Cell at(const int x, const int y) const { return cells[y * width + x]; }
 };
 
 class GameEngine {
     int boardWidth = 10, boardHeight = 20;
 
-    Board& board;
-    ScoreManager& scoreManager;
-    StorageManager& storageManager;
-    InputHandler& inputHandler;
-    BlockFactory& blockFactory;
-    std::unique_ptr<Block> holdBlock;
-    std::unique_ptr<Block> currentBlock;
-    Timer& tickTimer;
+    Board board;
+    ScoreManager scoreManager;
+    StorageManager storageManager;
+    InputHandler inputHandler;
+    BlockFactory blockFactory;
+    std::optional<Block> holdBlock;
+    std::optional<Block> currentBlock;
+    Timer tickTimer;
+    // Shared scheduler; when set it drives gravity and lock delay instead of tickTimer.
+    TimerWheel* scheduler = nullptr;
+    TimerWheel::TimerId gravityTimer;
+    TimerWheel::TimerId lockTimer;
     std::atomic<GameState> gameState;
     bool hasHeldThisTurn = false;
     int peekNextN = 3;
+    int piecesPlaced = 0;
+
+    // Fixed step clock:
+    ClockMode clockMode = ClockMode::REAL_TIME;
+    std::chrono::microseconds logicalTime{0};
+    // Real-time clock, read once per command so every check inside it sees the same instant.
+    std::chrono::steady_clock::time_point commandTime;
+    std::chrono::microseconds gravityElapsed{0};
+    long long elapsedFrames = 0;
+    static constexpr long long FRAMES_PER_SECOND = 60;
 
     // Soft lock:
     std::chrono::time_point<std::chrono::steady_clock> lockTimeStart;
@@ -50,45 +104,184 @@ class GameEngine {
     int lockResetCount = 0;
     const int MAX_LOCK_RESETS = 15;
 
-    mutable std::recursive_mutex gameMutex;
-    std::shared_ptr<IObserver> observer = nullptr;
+    // Checkpoint history, one entry per game start or load and one per locked piece:
+    bool checkpointing = false;
+    CheckpointLog checkpoints;
+    Snapshot checkpointScratch{};
+
+    // Replay recording:
+    bool recording = false;
+    ReplayRecorder recorder;
+    std::chrono::steady_clock::time_point recordingStart;
+
+    mutable std::mutex gameMutex;
+    std::weak_ptr<IObserver> observer;
     void notifyObserver();
 
-    RenderData cachedRenderData;
+    // Command queue:
+    std::atomic<DispatchMode> dispatchMode{DispatchMode::DIRECT};
+    MpscQueue<EngineCommand> commands;
+    CommandLatency latency;
 
-    GameEngine(int boardWidth, int boardHeight, InputHandler& input_handler, ScoreManager& score_manager);
-    ~GameEngine();
+    void dispatch(EngineCommandType type, int argument = 0);
+    int drainCommands();
+    void execute(const EngineCommand& command);
+
+    // Render cache. Frames are only built once someone can see them: after setObserver() or the
+    // first getRenderData(), so headless engines skip the work.
+    std::atomic<bool> publishing{false};
+    struct OverlayCell {
+        Position position;
+        Cell type;
+    };
+    RenderData renderState;
+    TripleBuffer<RenderData> frames;
+    std::array<RowSet, 3> staleRows{~RowSet{0}, ~RowSet{0}, ~RowSet{0}};
+    std::array<OverlayCell, 8> overlay{};
+    int overlayCount = 0;
+    std::vector<Cell> nextScratch;
+    std::uint64_t ghostKey = 0;
+    Position ghostPosition{0, 0};
+
+    int collectOverlay(std::array<OverlayCell, 8>& cells);
+    bool composeRenderState();
+    void publishFrame();
+
+    void applyReset();
+    void applyStartNewGame(int level);
+    void applyStartGame();
+    void applyPause();
+    void applyResume();
+    void applyTick(int rows);
+    void applyLock();
+    void applyMove(int dx);
+    void applyRotate(bool clockwise);
+    void applyHardDrop();
+    void applySoftDrop();
+    void applyHold();
+    void applySave();
+    void applyLoad();
+    void applyAdvanceTime(std::chrono::microseconds duration);
+    void advanceBy(std::chrono::microseconds duration);
+    void applyAdvanceFrames(int frames);
+    Snapshot captureSnapshot();
+    void applySnapshot(const Snapshot& snapshot);
+    void recordCheckpoint();
+    void restartCheckpoints();
+    bool applyRewind(size_t index);
+    void recordCommand(const EngineCommand& command);
+    void finishRecording();
+    ReplayOutcome captureOutcome() const;
+    std::uint64_t captureStateHash() const;
 
     void spawnNextBlock();
+    void lockCurrentBlock();
+    void startGravity();
+    void stopGravity();
+    void armLockDeadline();
+    void sampleClock();
+    std::chrono::steady_clock::time_point now() const;
 public:
+    explicit GameEngine(int boardWidth = 10, int boardHeight = 20, Leaderboard* leaderboard = nullptr);
+    ~GameEngine();
     GameEngine(const GameEngine&) = delete;
     GameEngine& operator=(const GameEngine&) = delete;
-    static GameEngine& getInstance(int boardWidth, int boardHeight, InputHandler& input_handler, ScoreManager& score_manager);
 
     void setObserver(std::shared_ptr<IObserver> observer);
+    InputHandler& getInputHandler();
+    ScoreManager& getScoreManager();
 
     void startNewGame(int level = 1);
     void startGame();
     void pause();
     void resume();
-    void tick();
+    // Applies `rows` gravity steps at once, so a late timer catches up instead of losing rows.
+    void tick(int rows = 1);
     void reset();
 
+    // In QUEUED mode every mutation below that maps to an EngineCommand is posted to a lock-free
+    // queue and only runs when the owning thread calls processCommands(), so inputs and timer
+    // ticks never contend and apply in a single order. Switch modes from the owning thread.
+    void setDispatchMode(DispatchMode mode);
+    DispatchMode getDispatchMode() const;
+    int processCommands();
+    CommandLatency getCommandLatency() const;
+
+    void seed(std::uint64_t seed, std::uint64_t stream = 0, RngEngine engine = RngEngine::PCG32);
+    std::uint64_t getSeed() const;
+    std::uint64_t getSeedStream() const;
+
+    // The wheel must outlive the engine. Pass nullptr to go back to the engine's own timer.
+    void setScheduler(TimerWheel* scheduler);
+
+    void setClockMode(ClockMode mode);
+    ClockMode getClockMode() const;
+    void advanceTime(std::chrono::microseconds duration);
+    void advanceFrames(int frames);
+    std::chrono::microseconds getLogicalTime() const;
+    // Fast path for an engine that only one thread ever touches, such as BatchEnvironment's:
+    // the same as dispatching the command or advancing, without the lock or the command queue.
+    void executeUnlocked(EngineCommandType type, int argument = 0);
+    void advanceFramesUnlocked(int frames);
+
     void requestMove(int dx);
     void requestRotate(bool clockwise);
     void requestHardDrop();
     void requestSoftDrop();
     void requestHold();
-    void requestSave() const;
+    void requestSave();
     void requestLoad();
-    void updateLevelSpeed() const;
+    // Named slots in the shared save store. These run on the caller's thread in either
+    // dispatch mode, like restoreFromSnapshot().
+    bool saveToSlot(const std::string& slot);
+    bool loadFromSlot(const std::string& slot);
+    std::vector<SaveSlotInfo> listSaveSlots();
+    // Called by ScoreManager from inside a mutation, so it does not take the lock.
+    void updateLevelSpeed();
 
     GameState getGameState() const;
     std::pair<int, int> getBoardSize() const;
+    int getPiecesPlaced() const;
+    std::optional<Block> getCurrentBlock() const;
+    std::vector<Cell> peekNext(int count);
+    void peekNext(int count, std::vector<Cell>& preview);
+    Cell getHoldType() const;
+    bool canHold() const;
+    Position getSpawnPosition() const;
+    BitBoard getOccupancy() const;
+    // Board cells, hold piece, held flag and bag position.
+    std::uint64_t getStateHash() const;
     static int calculateGravityInterval(int level) ;
+    static std::chrono::microseconds calculateGravityPeriod(int level);
 
+    // Latest published frame, read without locking. Meant for a single render thread; the
+    // reference stays valid until that thread calls getRenderData() again. The first call, or
+    // attaching an observer, turns on frame publishing.
     const RenderData& getRenderData();
 
-    Snapshot createSnapshot() const;
+    Snapshot createSnapshot();
     void restoreFromSnapshot(const Snapshot& snapshot);
+
+    // Off by default. Enabling starts the history at the current state.
+    void setCheckpointing(bool enabled);
+    bool isCheckpointing() const;
+    size_t getCheckpointCount() const;
+    Snapshot getCheckpoint(size_t index) const;
+    size_t getCheckpointMemoryUsage() const;
+    // Restores checkpoint `index`, drops the ones after it and leaves the game paused.
+    bool rewindTo(size_t index);
+    // Rewinds to just before the last locked piece.
+    bool undoPiece();
+
+    // Records every command the engine executes from here on, in the order it executes them,
+    // with its engine time. Restarts the piece sequence from the current seed, so call it before
+    // startNewGame(). Loading, restoring, rewinding, reseeding or switching clock mode ends the
+    // recording, since none of those can be replayed.
+    void startRecording();
+    Replay stopRecording();
+    bool isRecording() const;
+    // Runs the replay headlessly on this engine, as fast as it can, and returns where it ended.
+    // The result equals replay.outcome when the engine still behaves as it did when recording.
+    // Leaves the engine in FIXED_STEP mode.
+    ReplayOutcome playReplay(const Replay& replay);
 };
\ No newline at end of file
@@ -2,23 +2,20 @@
 #include "Commands/Commands.h"
 
 InputHandler::InputHandler() {
-    bind(KeyType::LEFT, &MoveLeftCommand::getInstance());
-    bind(KeyType::RIGHT, &MoveRightCommand::getInstance());
-    bind(KeyType::ROTATE_CW, &RotateCWCommand::getInstance());
-    bind(KeyType::ROTATE_CCW, &RotateCCWCommand::getInstance());
-    bind(KeyType::SOFT_DROP, &SoftDropCommand::getInstance());
-    bind(KeyType::HARD_DROP, &HardDropCommand::getInstance());
-    bind(KeyType::HOLD, &HoldCommand::getInstance());
-    bind(KeyType::PAUSE, &PauseCommand::getInstance());
-    bind(KeyType::RESUME, &ResumeCommand::getInstance());
-    bind(KeyType::SAVE, &SaveCommand::getInstance());
-    bind(KeyType::LOAD, &LoadCommand::getInstance());
+    bind(KeyType::LEFT, std::make_unique<MoveLeftCommand>());
+    bind(KeyType::RIGHT, std::make_unique<MoveRightCommand>());
+    bind(KeyType::ROTATE_CW, std::make_unique<RotateCWCommand>());
+    bind(KeyType::ROTATE_CCW, std::make_unique<RotateCCWCommand>());
+    bind(KeyType::SOFT_DROP, std::make_unique<SoftDropCommand>());
+    bind(KeyType::HARD_DROP, std::make_unique<HardDropCommand>());
+    bind(KeyType::HOLD, std::make_unique<HoldCommand>());
+    bind(KeyType::PAUSE, std::make_unique<PauseCommand>());
+    bind(KeyType::RESUME, std::make_unique<ResumeCommand>());
+    bind(KeyType::SAVE, std::make_unique<SaveCommand>());
+    bind(KeyType::LOAD, std::make_unique<LoadCommand>());
 }
 
-InputHandler& InputHandler::getInstance() {
-    static InputHandler instance;
-    return instance;
-};
+InputHandler::~InputHandler() = default;
 
 void InputHandler::setGameEngine(GameEngine* gameEngine) {
     this->engine = gameEngine;
@@ -30,8 +27,11 @@ void InputHandler::setGameEngine(GameEngine* gameEngine) {
     }
 };
 
-void InputHandler::bind(KeyType key, Command* command) {
-    bindings[key] = command;
+void InputHandler::bind(KeyType key, std::unique_ptr<Command> command) {
+    if (command) {
+        command->setGameEngine(engine);
+    }
+    bindings[key] = std::move(command);
 }
 
 void InputHandler::handleKey(const KeyType key) {
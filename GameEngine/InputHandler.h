@@ -1,5 +1,6 @@
 #pragma once
 #include <map>
+#include <memory>
 
 class GameEngine;
 class Command;
@@ -8,17 +9,16 @@ enum class KeyType { LEFT, RIGHT, ROTATE_CW, ROTATE_CCW, HARD_DROP, SOFT_DROP, H
 
 class InputHandler {
     GameEngine* engine = nullptr;
-    std::map<KeyType, Command*> bindings;
+    std::map<KeyType, std::unique_ptr<Command>> bindings;
 
-    InputHandler();
-    ~InputHandler() = default;
 public:
+    InputHandler();
+    ~InputHandler();
     InputHandler(const InputHandler&) = delete;
     InputHandler& operator=(const InputHandler&) = delete;
 
-    static InputHandler& getInstance();
     void setGameEngine(GameEngine* gameEngine);
 
-    void bind(KeyType key, Command* command);
+    void bind(KeyType key, std::unique_ptr<Command> command);
     void handleKey(KeyType key);
 };
@@ -0,0 +1,46 @@
+#pragma once
+#include <atomic>
+#include <utility>
+
+// Unbounded multi-producer, single-consumer queue. Producers link a node with one exchange and
+// never wait; the consumer owns the tail and may briefly miss a node whose link is still being
+// published, which the next pop picks up. Items from one producer keep their order.
+template <typename T>
+class MpscQueue {
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        T value{};
+    };
+
+    std::atomic<Node*> head;
+    Node* tail;
+
+public:
+    MpscQueue() : head(new Node), tail(head.load(std::memory_order_relaxed)) {}
+    ~MpscQueue() {
+        T discarded;
+        while (pop(discarded)) {}
+        delete tail;
+    }
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Producer side, any thread.
+    void push(T value) {
+        Node* node = new Node;
+        node->value = std::move(value);
+        Node* previous = head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    // Consumer side, one thread at a time.
+    bool pop(T& value) {
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next) return false;
+
+        value = std::move(next->value);
+        delete tail;
+        tail = next;
+        return true;
+    }
+};
@@ -0,0 +1,212 @@
+#include "Replay.h"
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#include "../GameEngine.h"
+#include "../SnapshotManagement/SnapshotCodec.h"
+#include "../SnapshotManagement/Varint.h"
+
+// Each event is a header byte holding the command type and two flags, then the optional fields.
+// Time is stored as the difference from when the event was expected: right after the previous
+// one, plus its duration if it was an ADVANCE, so fixed-step recordings never store time. ADVANCE
+// arguments are stored relative to the previous ADVANCE, since frames are nearly all the same.
+namespace {
+    constexpr std::uint8_t TYPE_MASK = 0x1F;
+    constexpr std::uint8_t HAS_ARGUMENT = 0x20;
+    constexpr std::uint8_t HAS_TIME = 0x40;
+
+    constexpr std::array<std::uint8_t, 4> MAGIC = {'T', 'R', 'P', 'L'};
+    constexpr size_t HEADER_SIZE = 4 + 2 + 1 + 1 + 8 + 8 + 1 + 8 + 4 + 4 + 4 + 8 + 4 + 4;
+
+    template <typename T>
+    void put(std::vector<std::uint8_t>& out, const T value) {
+        auto bits = static_cast<std::uint64_t>(value);
+        for (size_t i = 0; i < sizeof(T); ++i, bits >>= 8)
+            out.push_back(static_cast<std::uint8_t>(bits));
+    }
+
+    template <typename T>
+    T get(const std::uint8_t*& in) {
+        std::uint64_t bits = 0;
+        for (size_t i = 0; i < sizeof(T); ++i)
+            bits |= static_cast<std::uint64_t>(*in++) << 8 * i;
+        return static_cast<T>(bits);
+    }
+
+    bool skipVarint(const std::vector<std::uint8_t>& data, size_t& offset) {
+        for (int length = 0; offset < data.size() && length < 10; ++length) {
+            if (!(data[offset++] & 0x80)) return true;
+        }
+        return false;
+    }
+
+    // Walks every event with bounds checks, so ReplayReader can trust the stream afterwards.
+    bool validEvents(const Replay& replay) {
+        size_t offset = 0;
+        for (std::uint32_t event = 0; event < replay.eventCount; ++event) {
+            if (offset >= replay.events.size()) return false;
+            const std::uint8_t header = replay.events[offset++];
+            if ((header & TYPE_MASK) > static_cast<std::uint8_t>(EngineCommandType::ADVANCE)) return false;
+            if (header & HAS_TIME && !skipVarint(replay.events, offset)) return false;
+            if (header & HAS_ARGUMENT && !skipVarint(replay.events, offset)) return false;
+        }
+        return offset == replay.events.size();
+    }
+}
+
+bool ReplayOutcome::operator==(const ReplayOutcome& other) const {
+    return score == other.score && level == other.level && totalLinesCleared == other.totalLinesCleared &&
+           piecesPlaced == other.piecesPlaced && stateHash == other.stateHash;
+}
+
+bool ReplayOutcome::operator!=(const ReplayOutcome& other) const {
+    return !(*this == other);
+}
+
+void ReplayRecorder::start(const int boardWidth, const int boardHeight, const std::uint64_t seed,
+                           const std::uint64_t stream, const RngEngine rngEngine) {
+    replay = Replay{};
+    replay.boardWidth = boardWidth;
+    replay.boardHeight = boardHeight;
+    replay.seed = seed;
+    replay.stream = stream;
+    replay.rngEngine = rngEngine;
+    expectedTime = std::chrono::microseconds::zero();
+    lastAdvance = 0;
+}
+
+void ReplayRecorder::record(const ReplayEvent& event) {
+    const bool advance = event.type == EngineCommandType::ADVANCE;
+    const long long argument = advance ? static_cast<long long>(event.argument) - lastAdvance : event.argument;
+    const long long drift = (event.time - expectedTime).count();
+
+    auto header = static_cast<std::uint8_t>(event.type);
+    if (drift != 0) header |= HAS_TIME;
+    if (argument != 0) header |= HAS_ARGUMENT;
+    replay.events.push_back(header);
+    if (drift != 0) putSigned(replay.events, drift);
+    if (argument != 0) putSigned(replay.events, argument);
+    replay.eventCount++;
+
+    expectedTime = event.time;
+    if (advance) {
+        expectedTime += std::chrono::microseconds(event.argument);
+        lastAdvance = event.argument;
+    }
+}
+
+Replay& ReplayRecorder::getReplay() {
+    return replay;
+}
+
+Replay ReplayRecorder::take() {
+    return std::exchange(replay, Replay{});
+}
+
+ReplayReader::ReplayReader(const Replay& replay) :
+    replay(replay),
+    remaining(replay.eventCount)
+{}
+
+bool ReplayReader::next(ReplayEvent& event) {
+    if (remaining == 0) return false;
+    remaining--;
+
+    const std::uint8_t* in = replay.events.data() + offset;
+    const std::uint8_t header = *in++;
+    event.type = static_cast<EngineCommandType>(header & TYPE_MASK);
+    const bool advance = event.type == EngineCommandType::ADVANCE;
+
+    event.time = expectedTime;
+    if (header & HAS_TIME) event.time += std::chrono::microseconds(getSigned(in));
+    event.argument = advance ? lastAdvance : 0;
+    if (header & HAS_ARGUMENT) event.argument += static_cast<int>(getSigned(in));
+    offset = static_cast<size_t>(in - replay.events.data());
+
+    expectedTime = event.time;
+    if (advance) {
+        expectedTime += std::chrono::microseconds(event.argument);
+        lastAdvance = event.argument;
+    }
+    return true;
+}
+
+void encodeReplay(const Replay& replay, std::vector<std::uint8_t>& out) {
+    out.clear();
+    out.reserve(HEADER_SIZE + replay.events.size() + sizeof(std::uint32_t));
+
+    out.insert(out.end(), MAGIC.begin(), MAGIC.end());
+    put(out, REPLAY_FORMAT_VERSION);
+    put(out, static_cast<std::uint8_t>(replay.boardWidth));
+    put(out, static_cast<std::uint8_t>(replay.boardHeight));
+    put(out, replay.seed);
+    put(out, replay.stream);
+    put(out, static_cast<std::uint8_t>(replay.rngEngine));
+
+    put(out, static_cast<std::int64_t>(replay.outcome.score));
+    put(out, static_cast<std::int32_t>(replay.outcome.level));
+    put(out, static_cast<std::int32_t>(replay.outcome.totalLinesCleared));
+    put(out, static_cast<std::int32_t>(replay.outcome.piecesPlaced));
+    put(out, replay.outcome.stateHash);
+
+    put(out, replay.eventCount);
+    put(out, static_cast<std::uint32_t>(replay.events.size()));
+    out.insert(out.end(), replay.events.begin(), replay.events.end());
+
+    put(out, crc32(out.data(), out.size()));
+}
+
+bool decodeReplay(const std::uint8_t* data, const size_t size, Replay& replay) {
+    if (size < HEADER_SIZE + sizeof(std::uint32_t) || std::memcmp(data, MAGIC.data(), MAGIC.size()) != 0) return false;
+
+    const size_t payload = size - sizeof(std::uint32_t);
+    const std::uint8_t* checksum = data + payload;
+    if (get<std::uint32_t>(checksum) != crc32(data, payload)) return false;
+
+    const std::uint8_t* in = data + MAGIC.size();
+    if (get<std::uint16_t>(in) != REPLAY_FORMAT_VERSION) return false;
+    replay.boardWidth = get<std::uint8_t>(in);
+    replay.boardHeight = get<std::uint8_t>(in);
+    replay.seed = get<std::uint64_t>(in);
+    replay.stream = get<std::uint64_t>(in);
+    const auto rngEngine = get<std::uint8_t>(in);
+    if (rngEngine > static_cast<std::uint8_t>(RngEngine::MT19937)) return false;
+    replay.rngEngine = static_cast<RngEngine>(rngEngine);
+
+    replay.outcome.score = get<std::int64_t>(in);
+    replay.outcome.level = get<std::int32_t>(in);
+    replay.outcome.totalLinesCleared = get<std::int32_t>(in);
+    replay.outcome.piecesPlaced = get<std::int32_t>(in);
+    replay.outcome.stateHash = get<std::uint64_t>(in);
+
+    replay.eventCount = get<std::uint32_t>(in);
+    const auto eventBytes = get<std::uint32_t>(in);
+    if (eventBytes != payload - HEADER_SIZE) return false;
+    replay.events.assign(in, in + eventBytes);
+
+    return validEvents(replay);
+}
+
+bool writeReplayFile(const std::string& path, const Replay& replay) {
+    std::vector<std::uint8_t> bytes;
+    encodeReplay(replay, bytes);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(out.flush());
+}
+
+bool readReplayFile(const std::string& path, Replay& replay) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) return false;
+
+    const std::streamsize size = in.tellg();
+    if (size <= 0) return false;
+    std::vector<std::uint8_t> bytes(static_cast<size_t>(size));
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(bytes.data()), size)) return false;
+
+    return decodeReplay(bytes.data(), bytes.size(), replay);
+}
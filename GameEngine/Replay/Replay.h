@@ -0,0 +1,81 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../BlockFactory/BagGenerator.h"
+
+enum class EngineCommandType : std::uint8_t;
+
+// What the game looked like when recording stopped. Playback must reproduce all of it.
+struct ReplayOutcome {
+    long long score = 0;
+    int level = 0;
+    int totalLinesCleared = 0;
+    int piecesPlaced = 0;
+    std::uint64_t stateHash = 0;
+
+    bool operator==(const ReplayOutcome& other) const;
+    bool operator!=(const ReplayOutcome& other) const;
+};
+
+struct ReplayEvent {
+    EngineCommandType type;
+    int argument = 0;
+    // Engine time when the command ran, relative to the start of the recording.
+    std::chrono::microseconds time{0};
+};
+
+// Everything needed to re-run a game: the board size, the bag seed and every command the engine
+// executed, in order. Events are packed into `events` by ReplayRecorder and read back with
+// ReplayReader, typically one or two bytes per event.
+struct Replay {
+    int boardWidth = 10;
+    int boardHeight = 20;
+    std::uint64_t seed = 0;
+    std::uint64_t stream = 0;
+    RngEngine rngEngine = RngEngine::PCG32;
+
+    std::uint32_t eventCount = 0;
+    std::vector<std::uint8_t> events;
+    ReplayOutcome outcome;
+};
+
+class ReplayRecorder {
+    Replay replay;
+    std::chrono::microseconds expectedTime{0};
+    int lastAdvance = 0;
+
+public:
+    void start(int boardWidth, int boardHeight, std::uint64_t seed, std::uint64_t stream, RngEngine rngEngine);
+    void record(const ReplayEvent& event);
+    Replay& getReplay();
+    // Hands over the replay and leaves the recorder empty.
+    Replay take();
+};
+
+class ReplayReader {
+    const Replay& replay;
+    size_t offset = 0;
+    std::uint32_t remaining;
+    std::chrono::microseconds expectedTime{0};
+    int lastAdvance = 0;
+
+public:
+    explicit ReplayReader(const Replay& replay);
+
+    bool next(ReplayEvent& event);
+};
+
+// File layout, integers little-endian: magic "TRPL", u16 version, u8 width, u8 height,
+// u64 seed, u64 stream, u8 rng engine, i64 score, i32 level, i32 lines, i32 pieces,
+// u64 state hash, u32 event count, u32 event bytes, the events, then a CRC-32 of it all.
+constexpr std::uint16_t REPLAY_FORMAT_VERSION = 1;
+
+void encodeReplay(const Replay& replay, std::vector<std::uint8_t>& out);
+// Rejects a bad magic, an unknown version, a bad checksum and truncation.
+bool decodeReplay(const std::uint8_t* data, size_t size, Replay& replay);
+bool writeReplayFile(const std::string& path, const Replay& replay);
+bool readReplayFile(const std::string& path, Replay& replay);
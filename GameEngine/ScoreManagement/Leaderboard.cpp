@@ -7,11 +7,6 @@ Leaderboard::Leaderboard(const size_t max, const std::string &filepath) : maxEnt
     load();
 }
 
-Leaderboard& Leaderboard::getInstance(const size_t max, const std::string &filepath) {
-    static Leaderboard instance(max, filepath);
-    return instance;
-}
-
 bool Leaderboard::isAGoodScore(const long long score) const {
     return entries.size() < maxEntries || score >= entries.back().score;
 };
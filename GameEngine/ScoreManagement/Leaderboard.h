@@ -4,6 +4,7 @@
 #include <string>
 #include <iostream>
 #include <algorithm>
+#include <vector>
 
 
 class Leaderboard {
@@ -12,12 +13,10 @@ class Leaderboard {
     std::string filepath;
 
 public:
-    Leaderboard(size_t max, const std::string &filepath);
+    explicit Leaderboard(size_t max = 5, const std::string &filepath = "leaderboard");
     Leaderboard(const Leaderboard&) = delete;
     Leaderboard& operator=(const Leaderboard&) = delete;
 
-    static Leaderboard& getInstance(size_t max = 5, const std::string &filepath = "leaderboard");
-
     bool isAGoodScore(long long score) const;
     bool isANewRecord(long long score) const;
 
@@ -2,12 +2,7 @@
 #include "../GameEngine.h"
 #include "SnapshotManagement/Snapshot.h"
 
-ScoreManager::ScoreManager() : leaderboard(Leaderboard::getInstance()) {}
-
-ScoreManager& ScoreManager::getInstance() {
-    static ScoreManager instance;
-    return instance;
-}
+ScoreManager::ScoreManager(Leaderboard* leaderboard) : leaderboard(leaderboard) {}
 
 void ScoreManager::setGameEngine(GameEngine* gameEngine) {
     this->engine = gameEngine;
@@ -77,11 +72,15 @@ long long ScoreManager::getScore() const { return score; }
 int ScoreManager::getLevel() const { return level; }
 int ScoreManager::getTotalLinesCleared() const { return totalLinesCleared; }
 
-bool ScoreManager::isAGoodScore() const { return leaderboard.isAGoodScore(score); }
-bool ScoreManager::isANewRecord() const { return leaderboard.isANewRecord(score); }
+bool ScoreManager::isAGoodScore() const { return leaderboard && leaderboard->isAGoodScore(score); }
+bool ScoreManager::isANewRecord() const { return leaderboard && leaderboard->isANewRecord(score); }
 void ScoreManager::saveScore(const std::string& name) const {
-    leaderboard.addEntry(name, score);
-    leaderboard.save();
+    if (!leaderboard) return;
+    leaderboard->addEntry(name, score);
+    leaderboard->save();
 }
 
-std::vector<LeaderboardEntry> ScoreManager::getLeaderboard() const { return leaderboard.getEntries(); };
+std::vector<LeaderboardEntry> ScoreManager::getLeaderboard() const {
+    if (!leaderboard) return {};
+    return leaderboard->getEntries();
+}
@@ -11,13 +11,12 @@ class ScoreManager {
     int totalLinesCleared = 0;
     bool BackToBackTetrisPossibility = false;
     GameEngine* engine = nullptr;
-    Leaderboard& leaderboard;
+    Leaderboard* leaderboard;
 public:
-    ScoreManager();
+    explicit ScoreManager(Leaderboard* leaderboard = nullptr);
     ScoreManager(const ScoreManager&) = delete;
     ScoreManager& operator=(const ScoreManager&) = delete;
 
-    static ScoreManager& getInstance();
     void setGameEngine(GameEngine* gameEngine);
 
     void restoreFromSnapshot(const Snapshot& snapshot);
@@ -0,0 +1,147 @@
+#include "MoveGenerator.h"
+#include <algorithm>
+
+static constexpr std::array<std::array<std::uint8_t, 4>, 7> makeCanonicalRotations() {
+    std::array<std::array<std::uint8_t, 4>, 7> canonical{};
+    for (int type = 0; type < 7; ++type) {
+        for (int rotation = 0; rotation < 4; ++rotation) {
+            const ShapeMask& mask = BLOCK_SHAPE_MASKS[type][rotation];
+            int first = rotation;
+            for (int other = 0; other < rotation; ++other) {
+                const ShapeMask& candidate = BLOCK_SHAPE_MASKS[type][other];
+                if (candidate.width == mask.width && candidate.height == mask.height &&
+                    candidate.rows[0] == mask.rows[0] && candidate.rows[1] == mask.rows[1] &&
+                    candidate.rows[2] == mask.rows[2] && candidate.rows[3] == mask.rows[3]) {
+                    first = other;
+                    break;
+                }
+            }
+            canonical[type][rotation] = static_cast<std::uint8_t>(first);
+        }
+    }
+    return canonical;
+}
+
+// Rotations whose masks cover the same cells share an index, so resting placements compare by
+// (left, bottom, canonical rotation).
+static constexpr auto CANONICAL_ROTATIONS = makeCanonicalRotations();
+
+static_assert(CANONICAL_ROTATIONS[shapeIndex(Cell::O)][3] == 0);
+static_assert(CANONICAL_ROTATIONS[shapeIndex(Cell::S)][2] == 0);
+static_assert(CANONICAL_ROTATIONS[shapeIndex(Cell::T)][2] == 2);
+
+MoveGenerator::MoveGenerator() {
+    placements.reserve(256);
+}
+
+Block MoveGenerator::decode(const int node) const {
+    const int cell = node >> 2;
+    return {pieceType, {cell % stride - PADDING, cell / stride - PADDING}, static_cast<Rotation>(node & 3)};
+}
+
+const std::vector<Placement>& MoveGenerator::generate(const BitBoard& board, const Block& piece) {
+    placements.clear();
+    pieceType = piece.getType();
+    stride = board.getWidth() + 2 * PADDING;
+
+    const int nodeCount = stride * (board.getHeight() + 2 * PADDING) * 4;
+    std::fill_n(visited.begin(), (nodeCount + 63) / 64, 0);
+    std::fill_n(restingCells.begin(), (board.getHeight() * BitBoard::MAX_WIDTH * 4 + 63) / 64, 0);
+
+    if (pieceType == Cell::Empty) return placements;
+
+    const int type = shapeIndex(pieceType);
+    const auto& masks = BLOCK_SHAPE_MASKS[type];
+    const auto& canonical = CANONICAL_ROTATIONS[type];
+    const KickTable* kicks = pieceType == Cell::O ? nullptr
+                           : pieceType == Cell::I ? &I_WALL_KICK_DATA
+                           : &JLSTZ_WALL_KICK_DATA;
+
+    const Position start = piece.getPosition();
+    const int startRotation = static_cast<int>(piece.getRotation());
+    if (!board.fits(masks[startRotation], start)) return placements;
+
+    const int stackHeight = board.getStackHeight();
+
+    int head = 0, tail = 0;
+    const auto visit = [&](const int x, const int y, const int rotation, const int from, const PlacementMove move) {
+        const int node = encode(x, y, rotation);
+        std::uint64_t& word = visited[node >> 6];
+        const std::uint64_t bit = std::uint64_t{1} << (node & 63);
+        if (word & bit) return;
+
+        word |= bit;
+        parent[node] = static_cast<std::uint16_t>(from);
+        parentMove[node] = move;
+        queue[tail++] = static_cast<std::uint16_t>(node);
+    };
+
+    visit(start.x, start.y, startRotation, NO_PARENT, PlacementMove::SOFT_DROP);
+
+    while (head < tail) {
+        const int node = queue[head++];
+        const int rotation = node & 3;
+        const int cell = node >> 2;
+        const int x = cell % stride - PADDING;
+        const int y = cell / stride - PADDING;
+        const ShapeMask& mask = masks[rotation];
+
+        if (board.fits(mask, {x - 1, y})) visit(x - 1, y, rotation, node, PlacementMove::LEFT);
+        if (board.fits(mask, {x + 1, y})) visit(x + 1, y, rotation, node, PlacementMove::RIGHT);
+
+        if (y + mask.minY > stackHeight) {
+            // Above the stack nothing can block a move, so skip straight down to the surface.
+            visit(x, stackHeight - mask.minY, rotation, node, PlacementMove::SOFT_DROP);
+        } else if (board.fits(mask, {x, y - 1})) {
+            visit(x, y - 1, rotation, node, PlacementMove::SOFT_DROP);
+        } else {
+            const int left = x + mask.minX;
+            const int bottom = y + mask.minY;
+            const int key = (bottom * BitBoard::MAX_WIDTH + left) * 4 + canonical[rotation];
+            std::uint64_t& word = restingCells[key >> 6];
+            const std::uint64_t bit = std::uint64_t{1} << (key & 63);
+            if (!(word & bit)) {
+                word |= bit;
+                placements.push_back({Block(pieceType, {x, y}, static_cast<Rotation>(rotation)),
+                                      static_cast<std::uint16_t>(node)});
+            }
+        }
+
+        if (!kicks) continue;
+
+        for (const bool clockwise : {true, false}) {
+            const int target = clockwise ? (rotation + 1) % 4 : (rotation + 3) % 4;
+            const ShapeMask& rotated = masks[target];
+            const PlacementMove move = clockwise ? PlacementMove::ROTATE_CW : PlacementMove::ROTATE_CCW;
+
+            if (board.fits(rotated, {x, y})) {
+                visit(x, y, target, node, move);
+                continue;
+            }
+
+            const auto& offsets = (*kicks)[kickTransitionIndex(static_cast<Rotation>(rotation), static_cast<Rotation>(target))];
+            for (const auto& offset : offsets) {
+                const Position kicked{x + offset.x, y + offset.y};
+                if (board.fits(rotated, kicked)) {
+                    visit(kicked.x, kicked.y, target, node, move);
+                    break;
+                }
+            }
+        }
+    }
+
+    return placements;
+}
+
+std::vector<PlacementMove> MoveGenerator::pathTo(const Placement& placement) const {
+    std::vector<PlacementMove> path;
+    for (int node = placement.node; parent[node] != NO_PARENT; node = parent[node]) {
+        const int rows = parentMove[node] == PlacementMove::SOFT_DROP ? (parent[node] >> 2) / stride - (node >> 2) / stride : 1;
+        path.insert(path.end(), rows, parentMove[node]);
+    }
+    std::reverse(path.begin(), path.end());
+
+    while (!path.empty() && path.back() == PlacementMove::SOFT_DROP)
+        path.pop_back();
+    return path;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "../Board/BitBoard.h"
+#include "../Blocks/Block.h"
+
+enum class PlacementMove : std::uint8_t { LEFT, RIGHT, ROTATE_CW, ROTATE_CCW, SOFT_DROP };
+
+struct Placement {
+    Block block;
+    std::uint16_t node;
+};
+
+// Breadth-first flood fill over (x, y, rotation) reachable from the spawn state through shifts,
+// SRS rotations and soft drops. Every resting state with a distinct cell set is reported once.
+class MoveGenerator {
+    static constexpr int PADDING = 2;
+    static constexpr int MAX_NODES = (BitBoard::MAX_WIDTH + 2 * PADDING) * (BitBoard::MAX_HEIGHT + 2 * PADDING) * 4;
+    static constexpr int MAX_CELL_SETS = BitBoard::MAX_WIDTH * BitBoard::MAX_HEIGHT * 4;
+    static constexpr std::uint16_t NO_PARENT = 0xffff;
+
+    std::array<std::uint64_t, (MAX_NODES + 63) / 64> visited{};
+    std::array<std::uint64_t, (MAX_CELL_SETS + 63) / 64> restingCells{};
+    std::array<std::uint16_t, MAX_NODES> queue{};
+    std::array<std::uint16_t, MAX_NODES> parent{};
+    std::array<PlacementMove, MAX_NODES> parentMove{};
+    std::vector<Placement> placements;
+
+    int stride = 0;
+    Cell pieceType = Cell::Empty;
+
+    int encode(int x, int y, int rotation) const {
+        return ((y + PADDING) * stride + x + PADDING) * 4 + rotation;
+    }
+    Block decode(int node) const;
+
+public:
+    MoveGenerator();
+
+    const std::vector<Placement>& generate(const BitBoard& board, const Block& piece);
+
+    // Inputs leading from the generated spawn state to the placement, ending right before the
+    // hard drop. Only valid until the next call to generate().
+    std::vector<PlacementMove> pathTo(const Placement& placement) const;
+};
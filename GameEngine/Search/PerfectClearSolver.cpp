@@ -0,0 +1,250 @@
+#include "PerfectClearSolver.h"
+#include <algorithm>
+#include <climits>
+#include <optional>
+#include "../Board/Board.h"
+
+struct PerfectClearSolver::SearchContext {
+    std::vector<Cell> queue;
+    std::optional<Block> first;
+    Position spawn{0, 0};
+    std::uint64_t queueKey = 0;
+    std::atomic<int> solvedRoot{INT_MAX};
+    std::atomic<std::uint64_t> nodes{0};
+};
+
+struct PerfectClearSolver::Child {
+    BitBoard board;
+    PerfectClearStep step;
+    int next;
+    Cell hold;
+};
+
+static int countOccupied(const BitBoard& board) {
+    int cells = 0;
+    for (int y = 0; y < board.getStackHeight(); ++y)
+        cells += countCells(board.getRow(y));
+    return cells;
+}
+
+static int clearHeight(const BitBoard& board, const int remaining) {
+    return (countOccupied(board) + 4 * remaining) / board.getWidth();
+}
+
+// Every empty region below the clear height must be tiled by whole tetrominoes. Line clears only
+// ever bring cells of one column together, so an empty cell is joined both to its neighbours and
+// to the next empty cell above it in its column, even across filled cells whose rows may clear.
+static bool regionsDivisibleByFour(const BitBoard& board, const int limit) {
+    const RowMask full = board.getFullRowMask();
+    std::array<RowMask, BitBoard::MAX_HEIGHT> empty{};
+    for (int y = 0; y < limit; ++y)
+        empty[y] = ~board.getRow(y) & full;
+
+    for (int seedRow = 0; seedRow < limit; ++seedRow) {
+        while (empty[seedRow]) {
+            std::array<RowMask, BitBoard::MAX_HEIGHT> region{};
+            region[seedRow] = empty[seedRow] & (0u - empty[seedRow]);
+
+            bool grown = true;
+            while (grown) {
+                grown = false;
+                // Columns reaching row y from the region below or above, through filled cells.
+                RowMask up = 0;
+                for (int y = 0; y < limit; ++y) {
+                    const RowMask spread = (region[y] | (region[y] << 1) | (region[y] >> 1) | up) & empty[y];
+                    grown |= spread != region[y];
+                    region[y] = spread;
+                    up = region[y] | (up & ~empty[y]);
+                }
+                RowMask down = 0;
+                for (int y = limit; y-- > 0;) {
+                    const RowMask spread = (region[y] | down) & empty[y];
+                    grown |= spread != region[y];
+                    region[y] = spread;
+                    down = region[y] | (down & ~empty[y]);
+                }
+            }
+
+            int size = 0;
+            for (int y = 0; y < limit; ++y) {
+                size += countCells(region[y]);
+                empty[y] &= ~region[y];
+            }
+            if (size % 4 != 0) return false;
+        }
+    }
+    return true;
+}
+
+PerfectClearSolver::PerfectClearSolver(PerfectClearConfig config) :
+    config(config),
+    pool(config.threads),
+    failures(config.tableSize)
+{}
+
+void PerfectClearSolver::expand(const SearchContext& context, const BitBoard& board, const int next,
+                                const Cell hold, const int remaining, std::vector<Child>& children) const {
+    const int size = static_cast<int>(context.queue.size());
+    const int limit = clearHeight(board, remaining);
+
+    struct Choice { Cell piece; bool hold; int next; Cell held; };
+    Choice choices[2];
+    int choiceCount = 0;
+
+    if (next < size)
+        choices[choiceCount++] = {context.queue[next], false, next + 1, hold};
+    if (config.allowHold && next < size) {
+        if (hold != Cell::Empty && hold != context.queue[next])
+            choices[choiceCount++] = {hold, true, next + 1, context.queue[next]};
+        else if (hold == Cell::Empty && next + 1 < size)
+            choices[choiceCount++] = {context.queue[next + 1], true, next + 2, context.queue[next]};
+    }
+    if (next >= size && hold != Cell::Empty && config.allowHold)
+        choices[choiceCount++] = {hold, true, next, Cell::Empty};
+
+    thread_local MoveGenerator generator;
+    for (int c = 0; c < choiceCount; ++c) {
+        const Choice& choice = choices[c];
+        const Block start = next == 0 && !choice.hold && context.first ? *context.first : Block(choice.piece, context.spawn);
+
+        for (const auto& placement : generator.generate(board, start)) {
+            const ShapeMask& mask = placement.block.getShapeMask();
+            if (placement.block.getPosition().y + mask.minY + mask.height > limit) continue;
+
+            Child child{board, {choice.hold, placement.block, {}}, choice.next, choice.held};
+            child.board.place(mask, placement.block.getPosition());
+            child.board.clearFullLines();
+            children.push_back(std::move(child));
+        }
+    }
+}
+
+bool PerfectClearSolver::search(SearchContext& context, const BitBoard& board, const int next, const Cell hold,
+                                const int remaining, const int root, std::vector<PerfectClearStep>& steps) {
+    if (root > context.solvedRoot.load(std::memory_order_relaxed)) return false;
+    if (remaining == 0) return board.getStackHeight() == 0;
+
+    context.nodes.fetch_add(1, std::memory_order_relaxed);
+
+    // There is no checkerboard parity prune: every line clear flips the colour of the rows above it.
+    const int limit = clearHeight(board, remaining);
+    if (board.getStackHeight() > limit || !regionsDivisibleByFour(board, limit)) return false;
+
+    const std::uint64_t key = board.getHash() ^ context.queueKey ^
+        splitMix64(static_cast<std::uint64_t>(next) | static_cast<std::uint64_t>(remaining) << 16 |
+                   static_cast<std::uint64_t>(hold) << 32);
+    if (failures.probe(key)) return false;
+
+    std::vector<Child> children;
+    children.reserve(64);
+    expand(context, board, next, hold, remaining, children);
+
+    for (const auto& child : children) {
+        if (search(context, child.board, child.next, child.hold, remaining - 1, root, steps)) {
+            steps.push_back(child.step);
+            return true;
+        }
+    }
+
+    // A subtree cut short because a lower root already succeeded is not a proven failure.
+    if (root <= context.solvedRoot.load(std::memory_order_relaxed))
+        failures.store(key, 0.0);
+    return false;
+}
+
+void PerfectClearSolver::buildPaths(const SearchContext& context, BitBoard board, std::vector<PerfectClearStep>& steps) const {
+    MoveGenerator generator;
+    const auto sameCells = [](const Block& a, const Block& b) {
+        auto cellsA = a.getGlobalCellsAt(a.getPosition());
+        auto cellsB = b.getGlobalCellsAt(b.getPosition());
+        const auto byRow = [](const Position& l, const Position& r) { return l.y != r.y ? l.y < r.y : l.x < r.x; };
+        std::sort(cellsA.begin(), cellsA.end(), byRow);
+        std::sort(cellsB.begin(), cellsB.end(), byRow);
+        for (size_t i = 0; i < cellsA.size(); ++i) {
+            if (cellsA[i].x != cellsB[i].x || cellsA[i].y != cellsB[i].y) return false;
+        }
+        return true;
+    };
+
+    for (size_t i = 0; i < steps.size(); ++i) {
+        PerfectClearStep& step = steps[i];
+        const Block start = i == 0 && !step.hold && context.first ? *context.first : Block(step.block.getType(), context.spawn);
+
+        for (const auto& placement : generator.generate(board, start)) {
+            if (sameCells(placement.block, step.block)) {
+                step.path = generator.pathTo(placement);
+                break;
+            }
+        }
+        board.place(step.block.getShapeMask(), step.block.getPosition());
+        board.clearFullLines();
+    }
+}
+
+PerfectClearResult PerfectClearSolver::solve(const Snapshot& snapshot, const std::vector<Cell>& extraQueue) {
+    const int height = static_cast<int>(snapshot.grid.size());
+    const int width = height > 0 ? static_cast<int>(snapshot.grid[0].size()) : 0;
+    if (width == 0) return {};
+
+    Board layout(width, height);
+    layout.setGrid(snapshot.grid);
+    const BitBoard& start = layout.getOccupancy();
+
+    SearchContext context;
+    context.spawn = layout.getSpawnPosition();
+    if (snapshot.currentBlockType != Cell::Empty) {
+        context.queue.push_back(snapshot.currentBlockType);
+        context.first = Block(snapshot.currentBlockType, snapshot.currentBlockPosition, snapshot.currentBlockRotation);
+    }
+    context.queue.insert(context.queue.end(), snapshot.bag.begin(), snapshot.bag.end());
+    context.queue.insert(context.queue.end(), extraQueue.begin(), extraQueue.end());
+
+    for (size_t i = 0; i < context.queue.size() && i < zobrist::MAX_QUEUE; ++i)
+        context.queueKey ^= zobrist::queueSlot(static_cast<int>(i), context.queue[i]);
+    context.queueKey ^= zobrist::QUEUE_LENGTH[std::min<size_t>(context.queue.size(), zobrist::MAX_QUEUE)];
+
+    const int filled = countOccupied(start);
+    const int available = static_cast<int>(context.queue.size()) + (snapshot.holdBlockType != Cell::Empty ? 1 : 0);
+
+    // Keys leave out the board size and any pieces past zobrist::MAX_QUEUE, so failures proven
+    // for an earlier snapshot cannot be trusted for this one.
+    failures.clear();
+
+    PerfectClearResult result;
+    for (int pieces = 1; pieces <= std::min(config.maxPieces, available); ++pieces) {
+        if ((filled + 4 * pieces) % width != 0 || (filled + 4 * pieces) / width > height) continue;
+
+        std::vector<Child> roots;
+        expand(context, start, 0, snapshot.holdBlockType, pieces, roots);
+
+        std::vector<std::vector<PerfectClearStep>> solutions(roots.size());
+        // Owners pop their newest task first, so submit in reverse to try roots in index order.
+        WorkStealingPool::TaskGroup group;
+        for (size_t i = roots.size(); i-- > 0;) {
+            pool.submit(group, [&, i] {
+                const Child& root = roots[i];
+                const int index = static_cast<int>(i);
+                if (!search(context, root.board, root.next, root.hold, pieces - 1, index, solutions[i])) return;
+
+                int solved = context.solvedRoot.load();
+                while (index < solved && !context.solvedRoot.compare_exchange_weak(solved, index)) {}
+            });
+        }
+        pool.wait(group);
+
+        const int solved = context.solvedRoot.load();
+        if (solved == INT_MAX) continue;
+
+        auto& steps = solutions[solved];
+        steps.push_back(roots[solved].step);
+        std::reverse(steps.begin(), steps.end());
+        buildPaths(context, start, steps);
+
+        result.found = true;
+        result.steps = std::move(steps);
+        break;
+    }
+
+    result.nodes = context.nodes.load();
+    return result;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "MoveGenerator.h"
+#include "TranspositionTable.h"
+#include "WorkStealingPool.h"
+#include "SnapshotManagement/Snapshot.h"
+
+struct PerfectClearConfig {
+    int maxPieces = 10;
+    int threads = 0;
+    bool allowHold = true;
+    size_t tableSize = 1 << 20;
+};
+
+struct PerfectClearStep {
+    // Whether the hold key is pressed before moving this piece.
+    bool hold = false;
+    Block block;
+    std::vector<PlacementMove> path;
+};
+
+struct PerfectClearResult {
+    bool found = false;
+    std::vector<PerfectClearStep> steps;
+    std::uint64_t nodes = 0;
+};
+
+// Exhaustive search for a perfect clear using the known queue: the snapshot's current piece, its
+// hold slot, its bag preview and any extra pieces the caller supplies. Only placements that fit
+// below the clear height, the number of rows the remaining pieces fill exactly, are tried, and a
+// branch is dropped when an empty region that no line clear can merge with another is not a
+// multiple of four cells. Failed states are memoized in a table shared by the root-level tasks of
+// one solve.
+class PerfectClearSolver {
+    struct SearchContext;
+
+    PerfectClearConfig config;
+    WorkStealingPool pool;
+    TranspositionTable failures;
+
+    struct Child;
+
+    void expand(const SearchContext& context, const BitBoard& board, int next, Cell hold, int remaining,
+                std::vector<Child>& children) const;
+    bool search(SearchContext& context, const BitBoard& board, int next, Cell hold, int remaining,
+                int root, std::vector<PerfectClearStep>& steps);
+    void buildPaths(const SearchContext& context, BitBoard board, std::vector<PerfectClearStep>& steps) const;
+
+public:
+    explicit PerfectClearSolver(PerfectClearConfig config = {});
+
+    PerfectClearResult solve(const Snapshot& snapshot, const std::vector<Cell>& extraQueue = {});
+};
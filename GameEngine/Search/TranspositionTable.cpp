@@ -0,0 +1,51 @@
+#include "TranspositionTable.h"
+#include <cstring>
+
+static size_t roundUpToPowerOfTwo(const size_t value) {
+    size_t result = 1;
+    while (result < value)
+        result <<= 1;
+    return result;
+}
+
+// An empty slot is all zeros and would verify as key 0 holding 0.0, so key 0 is checked against
+// another constant instead. That constant can collide with a real key like any two keys can.
+static std::uint64_t checkedKey(const std::uint64_t key) {
+    return key != 0 ? key : 0x9e3779b97f4a7c15ull;
+}
+
+TranspositionTable::TranspositionTable(const size_t capacity) :
+    entries(new Entry[roundUpToPowerOfTwo(capacity)]),
+    mask(roundUpToPowerOfTwo(capacity) - 1)
+{}
+
+size_t TranspositionTable::getCapacity() const {
+    return mask + 1;
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i <= mask; ++i) {
+        entries[i].check.store(0, std::memory_order_relaxed);
+        entries[i].data.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::optional<double> TranspositionTable::probe(const std::uint64_t key) const {
+    const Entry& entry = entries[key & mask];
+    const std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+    const std::uint64_t check = entry.check.load(std::memory_order_relaxed);
+    if ((check ^ data) != checkedKey(key)) return std::nullopt;
+
+    double value;
+    std::memcpy(&value, &data, sizeof(value));
+    return value;
+}
+
+void TranspositionTable::store(const std::uint64_t key, const double value) {
+    std::uint64_t data;
+    std::memcpy(&data, &value, sizeof(data));
+
+    Entry& entry = entries[key & mask];
+    entry.data.store(data, std::memory_order_relaxed);
+    entry.check.store(checkedKey(key) ^ data, std::memory_order_relaxed);
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+// Fixed-size, always-replace table shared by all search threads without locks. Each slot stores
+// the key XORed with its payload, so a slot torn by a concurrent writer fails verification and
+// reads as a miss instead of returning another state's value.
+class TranspositionTable {
+    struct Entry {
+        std::atomic<std::uint64_t> check{0};
+        std::atomic<std::uint64_t> data{0};
+    };
+
+    std::unique_ptr<Entry[]> entries;
+    size_t mask;
+
+public:
+    // Capacity is rounded up to a power of two.
+    explicit TranspositionTable(size_t capacity = 1 << 16);
+
+    size_t getCapacity() const;
+    void clear();
+
+    std::optional<double> probe(std::uint64_t key) const;
+    void store(std::uint64_t key, double value);
+};
@@ -0,0 +1,107 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+
+namespace {
+    thread_local const WorkStealingPool* currentPool = nullptr;
+    thread_local int currentQueue = -1;
+}
+
+WorkStealingPool::WorkStealingPool(int threads) {
+    if (threads <= 0)
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    for (int i = 0; i < threads; ++i)
+        queues.push_back(std::make_unique<Queue>());
+
+    workers.reserve(threads - 1);
+    for (int i = 1; i < threads; ++i)
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+int WorkStealingPool::getThreadCount() const {
+    return static_cast<int>(queues.size());
+}
+
+int WorkStealingPool::ownQueue() {
+    if (currentPool == this) return currentQueue;
+    // Outside callers share the queues round robin; slot 0 has no dedicated worker thread.
+    return static_cast<int>(nextExternal++ % queues.size());
+}
+
+void WorkStealingPool::submit(TaskGroup& group, Task task) {
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+
+    Queue& queue = *queues[ownQueue()];
+    {
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.push_back([&group, task = std::move(task)] {
+            task();
+            group.pending.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    queued++;
+    if (sleeping.load() > 0) {
+        { std::lock_guard lock(sleepMutex); }
+        wake.notify_one();
+    }
+}
+
+bool WorkStealingPool::runOne(const int self) {
+    Task task;
+    const int count = static_cast<int>(queues.size());
+
+    for (int i = 0; i < count && !task; ++i) {
+        const int index = (self + i) % count;
+        Queue& queue = *queues[index];
+
+        std::lock_guard lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+
+        if (i == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+
+    if (!task) return false;
+    queued--;
+    task();
+    return true;
+}
+
+void WorkStealingPool::wait(TaskGroup& group) {
+    const int self = currentPool == this ? currentQueue : 0;
+    while (group.pending.load(std::memory_order_acquire) > 0) {
+        if (!runOne(self))
+            std::this_thread::yield();
+    }
+}
+
+void WorkStealingPool::workerLoop(const int index) {
+    currentPool = this;
+    currentQueue = index;
+
+    while (!stopping) {
+        if (runOne(index)) continue;
+
+        std::unique_lock lock(sleepMutex);
+        sleeping++;
+        wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+        sleeping--;
+    }
+}
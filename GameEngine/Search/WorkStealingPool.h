@@ -0,0 +1,54 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fork-join pool with one deque per worker. Owners push and pop at the back, idle workers steal
+// from the front of the others, and a thread waiting on a TaskGroup runs queued tasks meanwhile,
+// so nested groups never block a worker.
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    class TaskGroup {
+        std::atomic<int> pending{0};
+        friend class WorkStealingPool;
+    };
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::atomic<bool> stopping{false};
+    std::atomic<int> queued{0};
+    std::atomic<int> sleeping{0};
+    std::atomic<unsigned> nextExternal{0};
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+
+    int ownQueue();
+    bool runOne(int self);
+    void workerLoop(int index);
+
+public:
+    // threads counts the calling thread, which helps while it waits, so threads - 1 are spawned.
+    explicit WorkStealingPool(int threads = 0);
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int getThreadCount() const;
+
+    void submit(TaskGroup& group, Task task);
+    void wait(TaskGroup& group);
+};
@@ -0,0 +1,147 @@
+#include "CheckpointLog.h"
+#include <algorithm>
+#include <stdexcept>
+
+#include "Varint.h"
+
+namespace {
+    template <typename Iterator>
+    void putCells(std::vector<std::uint8_t>& out, Iterator begin, const Iterator end) {
+        for (; end - begin >= 2; begin += 2)
+            out.push_back(static_cast<std::uint8_t>(static_cast<int>(begin[0]) | static_cast<int>(begin[1]) << 4));
+        if (begin != end) out.push_back(static_cast<std::uint8_t>(*begin));
+    }
+
+    template <typename Iterator>
+    void getCells(const std::uint8_t*& in, Iterator output, const size_t count) {
+        for (size_t i = 0; i < count; ++i)
+            *output++ = static_cast<Cell>(i % 2 ? in[i / 2] >> 4 : in[i / 2] & 0x0F);
+        in += (count + 1) / 2;
+    }
+
+    // Smallest number of leading pieces to drop from `before` so that what is left is a
+    // prefix of `after`. Drawing pieces and refilling the bag only ever takes this shape.
+    size_t consumedPieces(const std::vector<Cell>& before, const std::vector<Cell>& after) {
+        for (size_t consumed = 0; consumed < before.size(); ++consumed) {
+            const size_t kept = before.size() - consumed;
+            if (kept <= after.size() && std::equal(before.begin() + consumed, before.end(), after.begin()))
+                return consumed;
+        }
+        return before.size();
+    }
+}
+
+CheckpointLog::CheckpointLog(const int width, const int height, const size_t keyframeInterval) :
+    width(width),
+    height(height),
+    keyframeInterval(std::max<size_t>(keyframeInterval, 1))
+{
+    blank.grid.assign(height, std::vector<Cell>(width, Cell::Empty));
+    blank.score = 0;
+    blank.level = 0;
+    blank.totalLinesCleared = 0;
+    blank.currentBlockType = Cell::Empty;
+    blank.currentBlockPosition = {0, 0};
+    blank.currentBlockRotation = Rotation::R0;
+    blank.holdBlockType = Cell::Empty;
+    previous = blank;
+}
+
+void CheckpointLog::append(const Snapshot& snapshot) {
+    const Snapshot& base = offsets.size() % keyframeInterval == 0 ? blank : previous;
+    offsets.push_back(static_cast<std::uint32_t>(data.size()));
+
+    putSigned(data, snapshot.score - base.score);
+    putSigned(data, snapshot.level - base.level);
+    putSigned(data, snapshot.totalLinesCleared - base.totalLinesCleared);
+    data.push_back(static_cast<std::uint8_t>(static_cast<int>(snapshot.currentBlockType) |
+                                             static_cast<int>(snapshot.holdBlockType) << 4));
+    data.push_back(static_cast<std::uint8_t>(snapshot.currentBlockRotation));
+    putSigned(data, snapshot.currentBlockPosition.x);
+    putSigned(data, snapshot.currentBlockPosition.y);
+
+    const size_t consumed = consumedPieces(base.bag, snapshot.bag);
+    const size_t kept = base.bag.size() - consumed;
+    putVarint(data, consumed);
+    putVarint(data, snapshot.bag.size() - kept);
+    putCells(data, snapshot.bag.begin() + static_cast<std::ptrdiff_t>(kept), snapshot.bag.end());
+
+    const size_t mask = data.size();
+    data.resize(mask + (height + 7) / 8, 0);
+    for (int y = 0; y < height; ++y) {
+        if (snapshot.grid[y] == base.grid[y]) continue;
+        data[mask + y / 8] |= static_cast<std::uint8_t>(1 << y % 8);
+        putCells(data, snapshot.grid[y].begin(), snapshot.grid[y].end());
+    }
+
+    previous = snapshot;
+}
+
+void CheckpointLog::decode(const size_t index, Snapshot& snapshot) const {
+    snapshot = blank;
+
+    for (size_t record = index - index % keyframeInterval; record <= index; ++record) {
+        const std::uint8_t* in = data.data() + offsets[record];
+
+        snapshot.score += getSigned(in);
+        snapshot.level += static_cast<int>(getSigned(in));
+        snapshot.totalLinesCleared += static_cast<int>(getSigned(in));
+        snapshot.currentBlockType = static_cast<Cell>(*in & 0x0F);
+        snapshot.holdBlockType = static_cast<Cell>(*in++ >> 4);
+        snapshot.currentBlockRotation = static_cast<Rotation>(*in++);
+        snapshot.currentBlockPosition.x = static_cast<int>(getSigned(in));
+        snapshot.currentBlockPosition.y = static_cast<int>(getSigned(in));
+
+        const size_t consumed = getVarint(in);
+        const size_t added = getVarint(in);
+        snapshot.bag.erase(snapshot.bag.begin(), snapshot.bag.begin() + static_cast<std::ptrdiff_t>(consumed));
+        const size_t kept = snapshot.bag.size();
+        snapshot.bag.resize(kept + added);
+        getCells(in, snapshot.bag.begin() + static_cast<std::ptrdiff_t>(kept), added);
+
+        const std::uint8_t* mask = in;
+        in += (height + 7) / 8;
+        for (int y = 0; y < height; ++y) {
+            if (mask[y / 8] >> y % 8 & 1)
+                getCells(in, snapshot.grid[y].begin(), static_cast<size_t>(width));
+        }
+    }
+}
+
+void CheckpointLog::get(const size_t index, Snapshot& snapshot) const {
+    if (index >= offsets.size()) throw std::out_of_range("Checkpoint index out of range");
+    decode(index, snapshot);
+}
+
+Snapshot CheckpointLog::get(const size_t index) const {
+    Snapshot snapshot;
+    get(index, snapshot);
+    return snapshot;
+}
+
+void CheckpointLog::truncate(const size_t count) {
+    if (count >= offsets.size()) return;
+
+    data.resize(offsets[count]);
+    offsets.resize(count);
+    if (count > 0)
+        decode(count - 1, previous);
+    else
+        previous = blank;
+}
+
+void CheckpointLog::clear() {
+    truncate(0);
+}
+
+size_t CheckpointLog::size() const {
+    return offsets.size();
+}
+
+bool CheckpointLog::empty() const {
+    return offsets.empty();
+}
+
+size_t CheckpointLog::getMemoryUsage() const {
+    return data.size() + offsets.size() * sizeof(std::uint32_t);
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Snapshot.h"
+
+// Append-only history of snapshots for one board size. Each checkpoint is stored as a delta
+// against the one before it: score, level and line deltas, the active and held piece, how far
+// the bag advanced plus the pieces it gained, and only the rows that changed. Every
+// keyframeInterval-th checkpoint is a delta against an empty board instead, so reading any
+// checkpoint replays at most keyframeInterval records.
+class CheckpointLog {
+    int width;
+    int height;
+    size_t keyframeInterval;
+
+    std::vector<std::uint8_t> data;
+    std::vector<std::uint32_t> offsets;
+    Snapshot blank;
+    // The last appended checkpoint, which the next one is encoded against.
+    Snapshot previous;
+
+    void decode(size_t index, Snapshot& snapshot) const;
+
+public:
+    CheckpointLog(int width, int height, size_t keyframeInterval = 32);
+
+    // The snapshot's grid must match the log's board size.
+    void append(const Snapshot& snapshot);
+    // Rebuilds checkpoint `index`, reusing the storage already in `snapshot`.
+    void get(size_t index, Snapshot& snapshot) const;
+    Snapshot get(size_t index) const;
+    // Drops every checkpoint from `count` on, so the next append follows checkpoint count - 1.
+    void truncate(size_t count);
+    void clear();
+
+    size_t size() const;
+    bool empty() const;
+    // Bytes held by the encoded records and their index.
+    size_t getMemoryUsage() const;
+};
@@ -0,0 +1,314 @@
+#include "SaveStore.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+
+#include "SnapshotCodec.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+struct SaveStore::Header {
+    char magic[4];
+    std::uint16_t version;
+    std::uint8_t width;
+    std::uint8_t height;
+    std::uint32_t capacity;
+    std::uint32_t recordSize;
+    std::uint8_t reserved[48];
+};
+
+struct SaveStore::SlotEntry {
+    char name[MAX_NAME_LENGTH + 1];
+    std::uint32_t reserved;
+    // 0 marks a free entry. Written last, as one aligned 8-byte store, to commit a save.
+    std::uint64_t sequence;
+    std::int64_t savedAtMs;
+};
+
+namespace {
+    constexpr char MAGIC[4] = {'T', 'S', 'L', 'T'};
+    constexpr std::uint16_t VERSION = 1;
+    constexpr size_t HEADER_SIZE = 64;
+    constexpr size_t ENTRY_SIZE = 64;
+    constexpr size_t RECORD_ALIGNMENT = 64;
+
+    // Unique per process and per store, so concurrent creators never share a temporary file.
+    std::string temporaryPath(const std::string& path, const void* owner) {
+#ifdef _WIN32
+        const auto process = GetCurrentProcessId();
+#else
+        const auto process = ::getpid();
+#endif
+        return path + "." + std::to_string(process) + "." +
+               std::to_string(reinterpret_cast<std::uintptr_t>(owner)) + ".tmp";
+    }
+
+    // Moves from to to, but never replaces an existing file.
+    void publish(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+        MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_WRITE_THROUGH);
+#else
+        ::link(from.c_str(), to.c_str());
+#endif
+    }
+}
+
+SaveStore::SaveStore(std::string path, const int boardWidth, const int boardHeight, const std::uint32_t capacity) :
+    path(std::move(path)),
+    boardWidth(boardWidth),
+    boardHeight(boardHeight)
+{
+    static_assert(sizeof(Header) == HEADER_SIZE);
+    static_assert(sizeof(SlotEntry) == ENTRY_SIZE);
+
+    const size_t record = sizeof(std::uint32_t) + maxEncodedSnapshotSize(boardWidth, boardHeight);
+    const auto expectedRecordSize = static_cast<std::uint32_t>((record + RECORD_ALIGNMENT - 1) / RECORD_ALIGNMENT * RECORD_ALIGNMENT);
+
+    std::error_code error;
+    if (!std::filesystem::exists(this->path, error))
+        create(std::max<std::uint32_t>(capacity, 1), expectedRecordSize);
+
+    if (!map(this->path, 0, false) || mappedSize < HEADER_SIZE) {
+        unmap();
+        return;
+    }
+
+    const auto& header = *reinterpret_cast<const Header*>(base);
+    this->capacity = header.capacity;
+    recordSize = header.recordSize;
+    const size_t expectedSize = HEADER_SIZE + static_cast<size_t>(this->capacity) * (ENTRY_SIZE + 2 * recordSize);
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.width != boardWidth || header.height != boardHeight || recordSize < expectedRecordSize ||
+        mappedSize < expectedSize) {
+        unmap();
+        return;
+    }
+
+    slots.reserve(this->capacity);
+    for (std::uint32_t slot = this->capacity; slot-- > 0;) {
+        const SlotEntry& slotEntry = entry(slot);
+        if (slotEntry.sequence == 0)
+            freeSlots.push_back(slot);
+        else
+            slots.emplace(std::string(slotEntry.name, strnlen(slotEntry.name, sizeof(slotEntry.name))), slot);
+    }
+}
+
+SaveStore::~SaveStore() {
+    unmap();
+}
+
+// The file is built under a temporary name and only moved to path once its header is on disk,
+// so a crash part way through never leaves a store that every later open rejects. Losing a race
+// to another creator is fine: the constructor then opens the file that creator published.
+void SaveStore::create(const std::uint32_t slotCapacity, const std::uint32_t slotRecordSize) {
+    const std::string temporary = temporaryPath(path, this);
+    std::error_code error;
+    std::filesystem::remove(temporary, error);
+
+    const size_t size = HEADER_SIZE + static_cast<size_t>(slotCapacity) * (ENTRY_SIZE + 2 * slotRecordSize);
+    const bool built = map(temporary, size, true);
+    if (built) {
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.width = static_cast<std::uint8_t>(boardWidth);
+        header.height = static_cast<std::uint8_t>(boardHeight);
+        header.capacity = slotCapacity;
+        header.recordSize = slotRecordSize;
+        std::memcpy(base, &header, sizeof(header));
+        flush(base, sizeof(header));
+    }
+    unmap();
+
+    if (built) publish(temporary, path);
+    std::filesystem::remove(temporary, error);
+}
+
+bool SaveStore::map(const std::string& file, size_t size, const bool create) {
+#ifdef _WIN32
+    fileHandle = CreateFileA(file.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+                             create ? CREATE_NEW : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        fileHandle = nullptr;
+        return false;
+    }
+    if (!create) {
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize)) return false;
+        size = static_cast<size_t>(fileSize.QuadPart);
+    }
+    if (size == 0) return false;
+
+    const auto size64 = static_cast<unsigned long long>(size);
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READWRITE,
+                                       static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64), nullptr);
+    if (!mappingHandle) return false;
+    void* address = MapViewOfFile(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!address) return false;
+#else
+    fd = ::open(file.c_str(), O_RDWR | O_CLOEXEC | (create ? O_CREAT | O_EXCL : 0), 0644);
+    if (fd < 0) return false;
+    if (create) {
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) return false;
+    } else {
+        struct stat status{};
+        if (::fstat(fd, &status) != 0) return false;
+        size = static_cast<size_t>(status.st_size);
+    }
+    if (size == 0) return false;
+
+    void* address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) return false;
+#endif
+    base = static_cast<std::uint8_t*>(address);
+    mappedSize = size;
+    return true;
+}
+
+void SaveStore::unmap() {
+#ifdef _WIN32
+    if (base) UnmapViewOfFile(base);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+    mappingHandle = fileHandle = nullptr;
+#else
+    if (base) ::munmap(base, mappedSize);
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+#endif
+    base = nullptr;
+    mappedSize = 0;
+}
+
+void SaveStore::flush(const void* address, const size_t length) const {
+#ifdef _WIN32
+    FlushViewOfFile(address, length);
+    FlushFileBuffers(fileHandle);
+#else
+    static const auto pageSize = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+    const auto begin = reinterpret_cast<std::uintptr_t>(address) & ~(pageSize - 1);
+    const auto end = reinterpret_cast<std::uintptr_t>(address) + length;
+    ::msync(reinterpret_cast<void*>(begin), end - begin, MS_SYNC);
+#endif
+}
+
+SaveStore::SlotEntry& SaveStore::entry(const std::uint32_t slot) const {
+    return *reinterpret_cast<SlotEntry*>(base + HEADER_SIZE + static_cast<size_t>(slot) * ENTRY_SIZE);
+}
+
+std::uint8_t* SaveStore::record(const std::uint32_t slot, const std::uint64_t sequence) const {
+    const size_t copy = static_cast<size_t>(slot) * 2 + (sequence & 1);
+    return base + HEADER_SIZE + static_cast<size_t>(capacity) * ENTRY_SIZE + copy * recordSize;
+}
+
+bool SaveStore::isOpen() const {
+    return base != nullptr;
+}
+
+bool SaveStore::save(const std::string& name, const Snapshot& snapshot) {
+    if (name.empty() || name.size() > MAX_NAME_LENGTH) return false;
+    if (snapshot.grid.size() != static_cast<size_t>(boardHeight) ||
+        snapshot.grid[0].size() != static_cast<size_t>(boardWidth))
+        return false;
+
+    std::lock_guard lock(mutex);
+    if (!base) return false;
+
+    const auto existing = slots.find(name);
+    if (existing == slots.end() && freeSlots.empty()) return false;
+    const std::uint32_t slot = existing != slots.end() ? existing->second : freeSlots.back();
+
+    encodeSnapshot(snapshot, scratch);
+    const auto length = static_cast<std::uint32_t>(scratch.size());
+    if (sizeof(length) + length > recordSize) return false;
+
+    SlotEntry& slotEntry = entry(slot);
+    const std::uint64_t sequence = slotEntry.sequence + 1;
+    std::uint8_t* target = record(slot, sequence);
+    std::memcpy(target, &length, sizeof(length));
+    std::memcpy(target + sizeof(length), scratch.data(), length);
+    flush(target, sizeof(length) + length);
+
+    if (existing == slots.end()) {
+        std::memset(slotEntry.name, 0, sizeof(slotEntry.name));
+        std::memcpy(slotEntry.name, name.data(), name.size());
+        freeSlots.pop_back();
+        slots.emplace(name, slot);
+    }
+    slotEntry.savedAtMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    slotEntry.sequence = sequence;
+    flush(&slotEntry, sizeof(slotEntry));
+    return true;
+}
+
+std::unique_ptr<Snapshot> SaveStore::load(const std::string& name) const {
+    std::lock_guard lock(mutex);
+    const auto found = slots.find(name);
+    if (found == slots.end()) return nullptr;
+
+    const std::uint8_t* source = record(found->second, entry(found->second).sequence);
+    std::uint32_t length;
+    std::memcpy(&length, source, sizeof(length));
+    if (sizeof(length) + length > recordSize) return nullptr;
+
+    auto snapshot = std::make_unique<Snapshot>();
+    if (!decodeSnapshot(source + sizeof(length), length, *snapshot)) return nullptr;
+    return snapshot;
+}
+
+bool SaveStore::remove(const std::string& name) {
+    std::lock_guard lock(mutex);
+    const auto found = slots.find(name);
+    if (found == slots.end()) return false;
+
+    SlotEntry& slotEntry = entry(found->second);
+    slotEntry.sequence = 0;
+    std::memset(slotEntry.name, 0, sizeof(slotEntry.name));
+    flush(&slotEntry, sizeof(slotEntry));
+
+    freeSlots.push_back(found->second);
+    slots.erase(found);
+    return true;
+}
+
+std::optional<SaveSlotInfo> SaveStore::find(const std::string& name) const {
+    std::lock_guard lock(mutex);
+    const auto found = slots.find(name);
+    if (found == slots.end()) return std::nullopt;
+
+    const SlotEntry& slotEntry = entry(found->second);
+    return SaveSlotInfo{found->first, slotEntry.sequence, slotEntry.savedAtMs};
+}
+
+std::vector<SaveSlotInfo> SaveStore::list() const {
+    std::vector<SaveSlotInfo> infos;
+    {
+        std::lock_guard lock(mutex);
+        infos.reserve(slots.size());
+        for (const auto& [name, slot] : slots) {
+            const SlotEntry& slotEntry = entry(slot);
+            infos.push_back({name, slotEntry.sequence, slotEntry.savedAtMs});
+        }
+    }
+    std::sort(infos.begin(), infos.end(), [](const SaveSlotInfo& a, const SaveSlotInfo& b) { return a.name < b.name; });
+    return infos;
+}
+
+size_t SaveStore::getSlotCount() const {
+    std::lock_guard lock(mutex);
+    return slots.size();
+}
+
+std::uint32_t SaveStore::getCapacity() const {
+    return capacity;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Snapshot.h"
+
+struct SaveSlotInfo {
+    std::string name;
+    std::uint64_t sequence = 0;
+    std::int64_t savedAtMs = 0;
+};
+
+// Many named snapshots in one memory-mapped file, in host byte order:
+//   64-byte header | capacity x 64-byte slot entries | capacity x 2 fixed-size record copies.
+// A slot's entry holds its name and a sequence number whose low bit picks the live copy. A save
+// writes the other copy, flushes it, then publishes it with a single store to the sequence, so
+// a crash mid-save leaves the previous snapshot readable. Slots are found through a name table
+// built from the entries on open; nothing reads other slots' records. That table is private to
+// each instance, so only one SaveStore should write a given file at a time.
+class SaveStore {
+public:
+    static constexpr size_t MAX_NAME_LENGTH = 43;
+
+private:
+    struct Header;
+    struct SlotEntry;
+
+    std::string path;
+    int boardWidth = 0;
+    int boardHeight = 0;
+    std::uint32_t capacity = 0;
+    std::uint32_t recordSize = 0;
+
+    std::uint8_t* base = nullptr;
+    size_t mappedSize = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fd = -1;
+#endif
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, std::uint32_t> slots;
+    std::vector<std::uint32_t> freeSlots;
+    std::vector<std::uint8_t> scratch;
+
+    void create(std::uint32_t slotCapacity, std::uint32_t slotRecordSize);
+    bool map(const std::string& file, size_t size, bool create);
+    void unmap();
+    void flush(const void* address, size_t length) const;
+
+    SlotEntry& entry(std::uint32_t slot) const;
+    std::uint8_t* record(std::uint32_t slot, std::uint64_t sequence) const;
+
+public:
+    // Opens the store at path, creating it with room for capacity slots if it does not exist.
+    SaveStore(std::string path, int boardWidth, int boardHeight, std::uint32_t capacity = 4096);
+    ~SaveStore();
+    SaveStore(const SaveStore&) = delete;
+    SaveStore& operator=(const SaveStore&) = delete;
+
+    // False if the file could not be mapped or belongs to a different board size.
+    bool isOpen() const;
+
+    // Creates or overwrites a slot. Fails when the name is too long or the store is full.
+    bool save(const std::string& name, const Snapshot& snapshot);
+    std::unique_ptr<Snapshot> load(const std::string& name) const;
+    bool remove(const std::string& name);
+
+    std::optional<SaveSlotInfo> find(const std::string& name) const;
+    std::vector<SaveSlotInfo> list() const;
+    size_t getSlotCount() const;
+    std::uint32_t getCapacity() const;
+};
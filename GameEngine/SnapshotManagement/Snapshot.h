@@ -4,8 +4,6 @@
 #include "Blocks/Block.h"
 #include "Board/Position.h"
 
-class Block;
-
 struct Snapshot {
     std::vector<std::vector<Cell>> grid;
 
@@ -19,5 +17,6 @@ struct Snapshot {
 
     Cell holdBlockType;
 
+    // Upcoming pieces in draw order.
     std::vector<Cell> bag;
 };
\ No newline at end of file
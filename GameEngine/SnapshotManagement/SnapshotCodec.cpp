@@ -0,0 +1,219 @@
+#include "SnapshotCodec.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+
+#include "../Blocks/BlockShapes.h"
+
+namespace {
+    constexpr std::array<std::uint8_t, 4> MAGIC = {'T', 'S', 'N', 'P'};
+    // Ghost cells are only ever drawn, never stored, and pieces are never Empty.
+    constexpr auto MIN_PIECE = static_cast<std::uint8_t>(Cell::I);
+    constexpr auto MAX_PIECE = static_cast<std::uint8_t>(Cell::Z);
+    constexpr auto MAX_ROTATION = static_cast<std::uint8_t>(Rotation::R270);
+    constexpr size_t FIXED_SIZE = 4 + 2 + 1 + 1 + 8 + 4 + 4 + 1 + 4 + 4 + 1 + 1 + 1 + 4;
+    constexpr size_t MAX_BAG = 255;
+
+    constexpr std::array<std::uint32_t, 256> makeCrcTable() {
+        std::array<std::uint32_t, 256> table{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+                crc = crc & 1 ? 0xEDB88320u ^ crc >> 1 : crc >> 1;
+            table[i] = crc;
+        }
+        return table;
+    }
+    constexpr auto CRC_TABLE = makeCrcTable();
+
+    class Writer {
+        std::vector<std::uint8_t>& out;
+
+    public:
+        explicit Writer(std::vector<std::uint8_t>& out) : out(out) {}
+
+        template <typename T>
+        void put(const T value) {
+            auto bits = static_cast<std::uint64_t>(value);
+            for (size_t i = 0; i < sizeof(T); ++i, bits >>= 8)
+                out.push_back(static_cast<std::uint8_t>(bits));
+        }
+
+        template <typename Iterator>
+        void putCells(Iterator begin, const Iterator end) {
+            std::uint8_t pending = 0;
+            bool half = false;
+            for (; begin != end; ++begin) {
+                const auto nibble = static_cast<std::uint8_t>(static_cast<std::uint8_t>(*begin) & 0x0F);
+                if (half) out.push_back(static_cast<std::uint8_t>(pending | nibble << 4));
+                else pending = nibble;
+                half = !half;
+            }
+            if (half) out.push_back(pending);
+        }
+    };
+
+    class Reader {
+        const std::uint8_t* data;
+        size_t size;
+        size_t offset = 0;
+
+    public:
+        bool ok = true;
+
+        Reader(const std::uint8_t* data, const size_t size) : data(data), size(size) {}
+
+        bool has(const size_t bytes) {
+            ok = ok && bytes <= size - offset;
+            return ok;
+        }
+
+        bool atEnd() const { return offset == size; }
+
+        template <typename T>
+        T get() {
+            if (!has(sizeof(T))) return T{};
+            std::uint64_t bits = 0;
+            for (size_t i = 0; i < sizeof(T); ++i)
+                bits |= static_cast<std::uint64_t>(data[offset + i]) << 8 * i;
+            offset += sizeof(T);
+            return static_cast<T>(bits);
+        }
+
+        Cell cell(const std::uint8_t value, const std::uint8_t min) {
+            ok = ok && value >= min && value <= MAX_PIECE;
+            return static_cast<Cell>(value);
+        }
+
+        // A piece type, or Empty when there is no piece.
+        Cell piece(const std::uint8_t value) {
+            return value == 0 ? Cell::Empty : cell(value, MIN_PIECE);
+        }
+
+        template <typename Output>
+        void getCells(const size_t count, Output output, const std::uint8_t min) {
+            if (!has((count + 1) / 2)) return;
+            for (size_t i = 0; i < count; ++i) {
+                const std::uint8_t byte = data[offset + i / 2];
+                *output++ = cell(i % 2 ? byte >> 4 : byte & 0x0F, min);
+            }
+            offset += (count + 1) / 2;
+        }
+    };
+
+    bool onBoard(const Snapshot& snapshot, const int width, const int height) {
+        if (snapshot.currentBlockType == Cell::Empty) return true;
+        const ShapeMask& shape = BLOCK_SHAPE_MASKS[shapeIndex(snapshot.currentBlockType)]
+                                                  [static_cast<int>(snapshot.currentBlockRotation)];
+        const long long left = static_cast<long long>(snapshot.currentBlockPosition.x) + shape.minX;
+        const long long bottom = static_cast<long long>(snapshot.currentBlockPosition.y) + shape.minY;
+        return left >= 0 && left + shape.width <= width && bottom >= 0 && bottom + shape.height <= height;
+    }
+
+    bool isPiece(const Cell cell) {
+        return static_cast<int>(cell) >= MIN_PIECE && static_cast<int>(cell) <= MAX_PIECE;
+    }
+}
+
+std::uint32_t crc32(const std::uint8_t* data, const size_t size, std::uint32_t crc) {
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i)
+        crc = CRC_TABLE[(crc ^ data[i]) & 0xFF] ^ crc >> 8;
+    return ~crc;
+}
+
+size_t maxEncodedSnapshotSize(const int width, const int height) {
+    return FIXED_SIZE + (MAX_BAG + 1) / 2 + static_cast<size_t>(height) * ((width + 1) / 2);
+}
+
+void encodeSnapshot(const Snapshot& snapshot, std::vector<std::uint8_t>& out) {
+    const size_t height = snapshot.grid.size();
+    const size_t width = height ? snapshot.grid[0].size() : 0;
+    const size_t bagLength = std::min(snapshot.bag.size(), MAX_BAG);
+
+    out.clear();
+    out.reserve(FIXED_SIZE + (bagLength + 1) / 2 + height * ((width + 1) / 2));
+    Writer writer(out);
+
+    out.insert(out.end(), MAGIC.begin(), MAGIC.end());
+    writer.put(SNAPSHOT_FORMAT_VERSION);
+    writer.put(static_cast<std::uint8_t>(width));
+    writer.put(static_cast<std::uint8_t>(height));
+
+    writer.put(static_cast<std::int64_t>(snapshot.score));
+    writer.put(static_cast<std::int32_t>(snapshot.level));
+    writer.put(static_cast<std::int32_t>(snapshot.totalLinesCleared));
+
+    writer.put(static_cast<std::uint8_t>(snapshot.currentBlockType));
+    writer.put(static_cast<std::int32_t>(snapshot.currentBlockPosition.x));
+    writer.put(static_cast<std::int32_t>(snapshot.currentBlockPosition.y));
+    writer.put(static_cast<std::uint8_t>(snapshot.currentBlockRotation));
+    writer.put(static_cast<std::uint8_t>(snapshot.holdBlockType));
+
+    writer.put(static_cast<std::uint8_t>(bagLength));
+    writer.putCells(snapshot.bag.begin(), snapshot.bag.begin() + static_cast<std::ptrdiff_t>(bagLength));
+    for (const auto& row : snapshot.grid)
+        writer.putCells(row.begin(), row.end());
+
+    writer.put(crc32(out.data(), out.size()));
+}
+
+bool isValidSnapshot(const Snapshot& snapshot) {
+    const size_t height = snapshot.grid.size();
+    const size_t width = height ? snapshot.grid[0].size() : 0;
+    if (width == 0) return false;
+
+    const auto rotation = static_cast<int>(snapshot.currentBlockRotation);
+    if (rotation < 0 || rotation > MAX_ROTATION) return false;
+    if (snapshot.currentBlockType != Cell::Empty && !isPiece(snapshot.currentBlockType)) return false;
+    if (snapshot.holdBlockType != Cell::Empty && !isPiece(snapshot.holdBlockType)) return false;
+    if (!std::all_of(snapshot.bag.begin(), snapshot.bag.end(), isPiece)) return false;
+
+    for (const auto& row : snapshot.grid) {
+        if (row.size() != width) return false;
+        for (const Cell cell : row) {
+            if (cell != Cell::Empty && !isPiece(cell)) return false;
+        }
+    }
+    return onBoard(snapshot, static_cast<int>(width), static_cast<int>(height));
+}
+
+bool isBinarySnapshot(const std::uint8_t* data, const size_t size) {
+    return size >= MAGIC.size() && std::memcmp(data, MAGIC.data(), MAGIC.size()) == 0;
+}
+
+bool decodeSnapshot(const std::uint8_t* data, const size_t size, Snapshot& snapshot) {
+    if (!isBinarySnapshot(data, size) || size < MAGIC.size() + sizeof(std::uint32_t)) return false;
+
+    const size_t payload = size - sizeof(std::uint32_t);
+    Reader checksum(data + payload, sizeof(std::uint32_t));
+    if (checksum.get<std::uint32_t>() != crc32(data, payload)) return false;
+
+    Reader reader(data + MAGIC.size(), payload - MAGIC.size());
+    if (reader.get<std::uint16_t>() != SNAPSHOT_FORMAT_VERSION) return false;
+    const auto width = reader.get<std::uint8_t>();
+    const auto height = reader.get<std::uint8_t>();
+
+    snapshot.score = reader.get<std::int64_t>();
+    snapshot.level = reader.get<std::int32_t>();
+    snapshot.totalLinesCleared = reader.get<std::int32_t>();
+
+    snapshot.currentBlockType = reader.piece(reader.get<std::uint8_t>());
+    snapshot.currentBlockPosition.x = reader.get<std::int32_t>();
+    snapshot.currentBlockPosition.y = reader.get<std::int32_t>();
+    const auto rotation = reader.get<std::uint8_t>();
+    reader.ok = reader.ok && rotation <= MAX_ROTATION;
+    snapshot.currentBlockRotation = static_cast<Rotation>(rotation);
+    snapshot.holdBlockType = reader.piece(reader.get<std::uint8_t>());
+
+    snapshot.bag.clear();
+    const auto bagLength = reader.get<std::uint8_t>();
+    reader.getCells(bagLength, std::back_inserter(snapshot.bag), MIN_PIECE);
+
+    snapshot.grid.assign(height, std::vector<Cell>(width, Cell::Empty));
+    for (auto& row : snapshot.grid)
+        reader.getCells(width, row.begin(), 0);
+
+    return reader.ok && reader.atEnd() && onBoard(snapshot, width, height);
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Snapshot.h"
+
+// Binary snapshot layout, all integers little-endian:
+//   magic "TSNP", u16 version, u8 width, u8 height,
+//   i64 score, i32 level, i32 total lines,
+//   u8 current type, i32 x, i32 y, u8 rotation, u8 hold type,
+//   u8 bag length, bag cells in draw order, then the board cells row by row as in Snapshot::grid,
+//   followed by a CRC-32 of everything before it.
+// Cells are packed two per byte, low nibble first, and each cell run starts on a byte boundary.
+constexpr std::uint16_t SNAPSHOT_FORMAT_VERSION = 1;
+
+std::uint32_t crc32(const std::uint8_t* data, size_t size, std::uint32_t crc = 0);
+
+// Upper bound on the encoded size of any snapshot of a width x height board.
+size_t maxEncodedSnapshotSize(int width, int height);
+void encodeSnapshot(const Snapshot& snapshot, std::vector<std::uint8_t>& out);
+// Piece types are Empty or I..Z, bag entries I..Z, grid cells Empty..Z, the rotation is in range
+// and the current piece lies on the board. decodeSnapshot applies the same rules.
+bool isValidSnapshot(const Snapshot& snapshot);
+bool isBinarySnapshot(const std::uint8_t* data, size_t size);
+// Rejects a bad magic, an unknown version, a bad checksum, truncation and out-of-range values.
+bool decodeSnapshot(const std::uint8_t* data, size_t size, Snapshot& snapshot);
@@ -1,53 +1,137 @@
 #include "StorageManager.h"
 #include "../GameEngine.h"
+#include "SnapshotCodec.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 
-static int cellToInt(Cell c) { return static_cast<int>(c); }
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 static Cell intToCell(int i) { return static_cast<Cell>(i); }
-static int rotationToInt(Rotation r) { return static_cast<int>(r); }
 static Rotation intToRotation(int i) { return static_cast<Rotation>(i); }
 
-StorageManager& StorageManager::getInstance() {
-    static StorageManager instance;
-    return instance;
+static bool writeFileAtomically(const std::string& path, const std::vector<std::uint8_t>& bytes) {
+    const std::string temporary = path + ".tmp";
+#ifdef _WIN32
+    FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) return false;
+
+    const bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size() &&
+                         std::fflush(file) == 0 && _commit(_fileno(file)) == 0;
+    const bool closed = std::fclose(file) == 0;
+    if (!written || !closed ||
+        !MoveFileExA(temporary.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+#else
+    const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+
+    size_t written = 0;
+    while (written < bytes.size()) {
+        const ssize_t count = ::write(fd, bytes.data() + written, bytes.size() - written);
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) break;
+        written += static_cast<size_t>(count);
+    }
+
+    const bool synced = written == bytes.size() && ::fsync(fd) == 0;
+    const bool closed = ::close(fd) == 0;
+    if (!synced || !closed || ::rename(temporary.c_str(), path.c_str()) != 0) {
+        ::unlink(temporary.c_str());
+        return false;
+    }
+
+    // Make the rename itself durable.
+    std::string directory = std::filesystem::path(path).parent_path().string();
+    if (directory.empty()) directory = ".";
+    if (const int dirFd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC); dirFd >= 0) {
+        ::fsync(dirFd);
+        ::close(dirFd);
+    }
+    return true;
+#endif
+}
+
+StorageManager::~StorageManager() {
+    {
+        std::lock_guard lock(writerMutex);
+        stopping = true;
+    }
+    writerWake.notify_one();
+    if (writer.joinable()) writer.join();
 }
 
 void StorageManager::setGameEngine(GameEngine* engine) {
     this->engine = engine;
 }
 
+void StorageManager::writerLoop() {
+    std::unique_lock lock(writerMutex);
+    while (true) {
+        writerWake.wait(lock, [&] { return stopping || !pendingSaves.empty(); });
+        if (pendingSaves.empty()) break;
+
+        const auto saves = std::move(pendingSaves);
+        pendingSaves.clear();
+        writing = true;
+
+        lock.unlock();
+        for (const auto& [slot, snapshot] : saves) {
+            const bool saved = slot.empty() ? serialize(snapshot) : getSlotStore().save(slot, snapshot);
+            if (!saved)
+                std::cerr << "Error saving game to " << (slot.empty() ? saveFilePath : slotStorePath + ":" + slot) << std::endl;
+        }
+        lock.lock();
 
-void StorageManager::serialize(const Snapshot& snapshot) const {
-    std::ofstream out(saveFilePath);
-    if (!out.is_open()) return;
-
-    out << snapshot.score << ";" << snapshot.level << ";" << snapshot.totalLinesCleared << "\n";
-
-    out << cellToInt(snapshot.currentBlockType) << ";"
-        << snapshot.currentBlockPosition.x << ";" << snapshot.currentBlockPosition.y << ";"
-        << rotationToInt(snapshot.currentBlockRotation) << "\n";
-
-    out << cellToInt(snapshot.holdBlockType) << "\n";
-
-    for (const Cell block : snapshot.bag) {
-        out << cellToInt(block) << " ";
+        writing = false;
+        writerIdle.notify_all();
     }
-    out << "\n";
+}
 
-    for (const auto& row : snapshot.grid) {
-        for (const Cell cell : row) {
-            out << cellToInt(cell) << " ";
-        }
-        out << "\n";
-    }
+bool StorageManager::serialize(const Snapshot& snapshot) const {
+    std::vector<std::uint8_t> bytes;
+    encodeSnapshot(snapshot, bytes);
+    return writeFileAtomically(saveFilePath, bytes);
 }
 
 std::unique_ptr<Snapshot> StorageManager::deserialize() const {
-    std::ifstream in(saveFilePath);
+    std::ifstream in(saveFilePath, std::ios::binary | std::ios::ate);
     if (!in.is_open()) return nullptr;
 
+    const std::streamsize size = in.tellg();
+    if (size <= 0) return nullptr;
+    std::string bytes(static_cast<size_t>(size), '\0');
+    in.seekg(0);
+    if (!in.read(bytes.data(), size)) return nullptr;
+
+    const auto* data = reinterpret_cast<const std::uint8_t*>(bytes.data());
+    if (!isBinarySnapshot(data, bytes.size())) return deserializeText(bytes);
+
+    auto snapshot = std::make_unique<Snapshot>();
+    if (!decodeSnapshot(data, bytes.size(), *snapshot)) return nullptr;
+
+    const auto [boardWidth, boardHeight] = engine->getBoardSize();
+    if (snapshot->grid.size() != static_cast<size_t>(boardHeight) ||
+        snapshot->grid[0].size() != static_cast<size_t>(boardWidth))
+        return nullptr;
+    return snapshot;
+}
+
+std::unique_ptr<Snapshot> StorageManager::deserializeText(const std::string& text) const {
+    std::istringstream in(text);
     Snapshot snapshot{};
     std::string line;
 
@@ -61,7 +145,7 @@ std::unique_ptr<Snapshot> StorageManager::deserialize() const {
 
     if (std::getline(in, line)) {
         std::stringstream ss(line);
-        int type, rot;
+        int type = -1, rot = -1;
         ss >> type; snapshot.currentBlockType = intToCell(type);
         ss.ignore(1);
         ss >> snapshot.currentBlockPosition.x;
@@ -73,7 +157,7 @@ std::unique_ptr<Snapshot> StorageManager::deserialize() const {
 
     if (std::getline(in, line)) {
         std::stringstream ss(line);
-        int type;
+        int type = -1;
         ss >> type; snapshot.holdBlockType = intToCell(type);
     } else return nullptr;
 
@@ -83,7 +167,6 @@ std::unique_ptr<Snapshot> StorageManager::deserialize() const {
         for (int i = 0; i < 7 && ss >> type; ++i) {
             snapshot.bag.emplace_back(intToCell(type));
         }
-        std::reverse(snapshot.bag.begin(), snapshot.bag.end());
     } else return nullptr;
 
     int boardWidth = engine->getBoardSize().first;
@@ -100,17 +183,41 @@ std::unique_ptr<Snapshot> StorageManager::deserialize() const {
             }
         } else return nullptr;
     }
+    if (!isValidSnapshot(snapshot)) return nullptr;
     return std::make_unique<Snapshot>(snapshot);
 }
 
-void StorageManager::saveGame() const {
-    if (!engine) return;
+SaveStore& StorageManager::getSlotStore() {
+    std::call_once(slotStoreOpened, [&] {
+        const auto [boardWidth, boardHeight] = engine->getBoardSize();
+        slotStore = std::make_unique<SaveStore>(slotStorePath, boardWidth, boardHeight);
+    });
+    return *slotStore;
+}
 
-    const Snapshot snapshot = engine->createSnapshot();
-    serialize(snapshot);
+void StorageManager::saveGame(Snapshot snapshot, const std::string& slot) {
+    {
+        std::lock_guard lock(writerMutex);
+        const auto pending = std::find_if(pendingSaves.begin(), pendingSaves.end(),
+                                          [&](const auto& save) { return save.first == slot; });
+        if (pending != pendingSaves.end())
+            pending->second = std::move(snapshot);
+        else
+            pendingSaves.emplace_back(slot, std::move(snapshot));
+        if (!writer.joinable())
+            writer = std::thread(&StorageManager::writerLoop, this);
+    }
+    writerWake.notify_one();
 }
 
-std::unique_ptr<Snapshot> StorageManager::loadGame() const {
+void StorageManager::flush() {
+    std::unique_lock lock(writerMutex);
+    writerIdle.wait(lock, [&] { return pendingSaves.empty() && !writing; });
+}
+
+std::unique_ptr<Snapshot> StorageManager::loadGame(const std::string& slot) {
+    flush();
+    if (!slot.empty()) return getSlotStore().load(slot);
     try {
         return deserialize();
     } catch (const std::exception& e) {
@@ -118,3 +225,8 @@ std::unique_ptr<Snapshot> StorageManager::loadGame() const {
         return nullptr;
     }
 }
+
+std::vector<SaveSlotInfo> StorageManager::listSlots() {
+    flush();
+    return getSlotStore().list();
+}
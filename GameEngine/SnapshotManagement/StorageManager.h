@@ -1,24 +1,56 @@
 #pragma once
+#include <condition_variable>
+#include <cstdint>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 #include "Snapshot.h"
+#include "SaveStore.h"
 
 class GameEngine;
 
 class StorageManager {
     const std::string saveFilePath = "tetris_save.dat";
+    const std::string slotStorePath = "tetris_slots.dat";
     GameEngine* engine = nullptr;
 
+    std::once_flag slotStoreOpened;
+    std::unique_ptr<SaveStore> slotStore;
+    SaveStore& getSlotStore();
+
+    // Background writer. Only the newest unwritten snapshot per slot is kept, so saves that
+    // arrive faster than the disk coalesce into one write. The empty slot is saveFilePath.
+    std::mutex writerMutex;
+    std::condition_variable writerWake;
+    std::condition_variable writerIdle;
+    std::vector<std::pair<std::string, Snapshot>> pendingSaves;
+    bool writing = false;
+    bool stopping = false;
+    std::thread writer;
+
+    void writerLoop();
+
+    bool serialize(const Snapshot& snapshot) const;
+    std::unique_ptr<Snapshot> deserialize() const;
+    // Whitespace-separated format written before the binary codec.
+    std::unique_ptr<Snapshot> deserializeText(const std::string& text) const;
+public:
     StorageManager() = default;
+    ~StorageManager();
     StorageManager(const StorageManager&) = delete;
     StorageManager& operator=(const StorageManager&) = delete;
 
-    void serialize(const Snapshot& snapshot) const;
-    std::unique_ptr<Snapshot> deserialize() const;
-public:
-    static StorageManager& getInstance();
     void setGameEngine(GameEngine* engine);
 
-    void saveGame() const; 
-    std::unique_ptr<Snapshot> loadGame() const;
+    // Queues the snapshot and returns at once. The save file is replaced atomically (temp
+    // file, fsync, rename) and named slots go to the SaveStore, so a crash mid-write leaves the
+    // previous save intact either way.
+    void saveGame(Snapshot snapshot, const std::string& slot = {});
+    // Blocks until every queued save is on disk.
+    void flush();
+    std::unique_ptr<Snapshot> loadGame(const std::string& slot = {});
+    std::vector<SaveSlotInfo> listSlots();
 };
\ No newline at end of file
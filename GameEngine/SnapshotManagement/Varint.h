@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// LEB128 varints, with zigzag for signed values, for compact in-memory streams. Readers trust
+// their input: only use them on bytes that were written by the matching put function.
+inline void putVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+inline void putSigned(std::vector<std::uint8_t>& out, const long long value) {
+    putVarint(out, static_cast<std::uint64_t>(value) << 1 ^ static_cast<std::uint64_t>(value >> 63));
+}
+
+inline std::uint64_t getVarint(const std::uint8_t*& in) {
+    std::uint64_t value = 0;
+    for (int shift = 0;; shift += 7) {
+        const std::uint8_t byte = *in++;
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+}
+
+inline long long getSigned(const std::uint8_t*& in) {
+    const std::uint64_t value = getVarint(in);
+    return static_cast<long long>(value >> 1) ^ -static_cast<long long>(value & 1);
+}
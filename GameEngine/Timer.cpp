@@ -1,11 +1,12 @@
 #include "Timer.h"
 #include "GameEngine.h"
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <utility>
 
-Timer& Timer::getInstance() {
-    static Timer instance;
-    return instance;
+Timer::~Timer() {
+    stop();
 }
 
 void Timer::setGameEngine(GameEngine* gameEngine) {
@@ -17,47 +18,76 @@ void Timer::setCallback(std::function<void()> func) {
 }
 
 void Timer::timingLoop() {
-    while (isRunning) {
-        std::unique_lock<std::mutex> lock(intervalMutex);
-        auto status = cv.wait_for(lock, std::chrono::milliseconds(intervalMs));
+    using Clock = std::chrono::steady_clock;
+
+    std::unique_lock<std::mutex> lock(intervalMutex);
+    auto lastTick = Clock::now();
+    auto lastWake = lastTick;
+    while (!shuttingDown) {
         if (!isRunning) {
-            break;
+            cv.wait(lock, [this] { return isRunning || shuttingDown; });
+            continue;
+        }
+        if (restarted) {
+            restarted = false;
+            lastTick = lastWake = Clock::now();
         }
 
-        if (status == std::cv_status::timeout) {
-            lock.unlock();
-            if (engine) {
-                engine->tick();
-            }
+        const auto deadline = std::max(lastTick + interval, lastWake + MIN_WAKE_INTERVAL);
+        if (cv.wait_until(lock, deadline) == std::cv_status::no_timeout) continue;
+        if (!isRunning) continue;
+
+        lastWake = Clock::now();
+        const auto rows = (lastWake - lastTick) / interval;
+        if (rows <= 0) continue;
+        lastTick += rows * interval;
+
+        lock.unlock();
+        if (engine) {
+            engine->tick(static_cast<int>(std::min<decltype(rows)>(rows, std::numeric_limits<int>::max())));
         }
+        lock.lock();
     }
 }
 
-void Timer::start(const int initialIntervalMs) {
+void Timer::start(const std::chrono::microseconds initialInterval) {
     if (isRunning.load()) {
-        setInterval(initialIntervalMs);
+        setInterval(initialInterval);
         return;
     }
 
-    if (workerThread.joinable() && workerThread.get_id() != std::this_thread::get_id()) {
-        workerThread.join();
+    std::lock_guard<std::mutex> lock(intervalMutex);
+    interval = std::max(initialInterval, std::chrono::microseconds(1));
+    isRunning = true;
+    restarted = true;
+    if (workerThread.joinable()) {
+        cv.notify_one();
+    } else {
+        shuttingDown = false;
+        workerThread = std::thread(&Timer::timingLoop, this);
     }
-    intervalMs = initialIntervalMs;
-    isRunning.store(true);
-    workerThread = std::thread(&Timer::timingLoop, this);
 }
 
 void Timer::stop() {
-    if (!isRunning) return;
-    isRunning = false;
-    cv.notify_one();
+    {
+        std::lock_guard<std::mutex> lock(intervalMutex);
+        isRunning = false;
+        shuttingDown = true;
+        cv.notify_one();
+    }
     if (workerThread.joinable() && workerThread.get_id() != std::this_thread::get_id()) {
         workerThread.join();
     }
 }
 
-void Timer::setInterval(const int newIntervalMs) {
+void Timer::requestStop() {
+    std::lock_guard<std::mutex> lock(intervalMutex);
+    isRunning = false;
+    cv.notify_one();
+}
+
+void Timer::setInterval(const std::chrono::microseconds newInterval) {
     std::lock_guard<std::mutex> lock(intervalMutex);
-    intervalMs = newIntervalMs;
+    interval = std::max(newInterval, std::chrono::microseconds(1));
     cv.notify_one();
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <functional>
 #include <thread>
 #include <chrono>
@@ -14,21 +15,32 @@ class Timer {
     std::condition_variable cv;
 
     std::atomic<bool> isRunning = false;
-    std::atomic<int> intervalMs = 1000;
+    // The worker outlives requestStop() and idles until the next start(); only stop() ends it.
+    bool shuttingDown = false;
+    bool restarted = false;
+    std::chrono::microseconds interval{1000000};
+
+    // Floor on how often the loop wakes; faster gravity is delivered as several rows per wake.
+    static constexpr std::chrono::microseconds MIN_WAKE_INTERVAL{250};
 
     GameEngine* engine = nullptr;
 
+    void timingLoop();
+public:
     Timer() = default;
+    ~Timer();
     Timer(const Timer&) = delete;
     Timer& operator=(const Timer&) = delete;
 
-    void timingLoop();
-public:
-    static Timer& getInstance();
     void setGameEngine(GameEngine* gameEngine);
 
     void setCallback(std::function<void()> func);
-    void start(int initialIntervalMs = 1000);
+    void start(std::chrono::microseconds initialInterval = std::chrono::seconds(1));
+    // Ends the worker thread and joins it. Never call it while holding a lock the callback
+    // takes, since the worker may be waiting on that lock; use requestStop() there instead.
     void stop();
-    void setInterval(int newIntervalMs);
+    // Stops ticking without blocking. A tick already in progress still completes.
+    void requestStop();
+    // Keeps the current tick phase: the next tick is due one new interval after the last one.
+    void setInterval(std::chrono::microseconds newInterval);
 };
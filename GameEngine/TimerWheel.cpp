@@ -0,0 +1,258 @@
+#include "TimerWheel.h"
+#include <algorithm>
+#include <limits>
+
+#include "Board/BitBoard.h"
+
+TimerWheel::TimerWheel(const Clock::duration resolution) :
+    epoch(Clock::now()),
+    resolution(std::max(resolution, Clock::duration(1)))
+{
+    worker = std::thread(&TimerWheel::workerLoop, this);
+}
+
+TimerWheel::~TimerWheel() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+}
+
+std::uint64_t TimerWheel::tickAt(const Clock::duration offset) const {
+    if (offset <= Clock::duration::zero()) return 0;
+    return static_cast<std::uint64_t>((offset + resolution - Clock::duration(1)) / resolution);
+}
+
+std::uint64_t TimerWheel::nextEventTick() const {
+    std::uint64_t next = std::numeric_limits<std::uint64_t>::max();
+
+    const int shift = static_cast<int>((currentTick + 1) & (SLOTS - 1));
+    const std::uint64_t rotated = shift ? occupied[0] >> shift | occupied[0] << (SLOTS - shift) : occupied[0];
+    if (rotated)
+        next = currentTick + 1 + lowestCell(rotated);
+
+    for (int level = 1; level < LEVELS; ++level) {
+        if (occupied[level]) {
+            next = std::min(next, (currentTick | (SLOTS - 1)) + 1);
+            break;
+        }
+    }
+    return next;
+}
+
+TimerWheel::Node* TimerWheel::find(const TimerId id) {
+    if (id.index >= nodes.size()) return nullptr;
+
+    Node& node = nodes[id.index];
+    if (node.generation != id.generation || node.list == FREE || node.list == CANCELLED) return nullptr;
+    return &node;
+}
+
+void TimerWheel::link(const std::uint32_t index, const int list) {
+    Node& node = nodes[index];
+    List& target = lists[list];
+
+    node.list = list;
+    node.prev = target.tail;
+    node.next = NONE;
+    if (target.tail != NONE)
+        nodes[target.tail].next = index;
+    else
+        target.head = index;
+    target.tail = index;
+
+    if (list < EXPIRED)
+        occupied[list / SLOTS] |= std::uint64_t{1} << (list % SLOTS);
+}
+
+void TimerWheel::unlink(const std::uint32_t index) {
+    Node& node = nodes[index];
+    List& source = lists[node.list];
+
+    if (node.prev != NONE) nodes[node.prev].next = node.next;
+    else source.head = node.next;
+    if (node.next != NONE) nodes[node.next].prev = node.prev;
+    else source.tail = node.prev;
+
+    if (node.list < EXPIRED && source.head == NONE)
+        occupied[node.list / SLOTS] &= ~(std::uint64_t{1} << (node.list % SLOTS));
+    node.prev = node.next = NONE;
+}
+
+void TimerWheel::insert(const std::uint32_t index) {
+    const std::uint64_t tick = tickAt(nodes[index].deadline);
+    if (tick <= currentTick) {
+        link(index, EXPIRED);
+        return;
+    }
+
+    const std::uint64_t delta = tick - currentTick;
+    for (int level = 0; level < LEVELS; ++level) {
+        if (delta < std::uint64_t{1} << SLOT_BITS * (level + 1)) {
+            link(index, level * SLOTS + static_cast<int>(tick >> SLOT_BITS * level & (SLOTS - 1)));
+            return;
+        }
+    }
+
+    // Beyond the wheel's range: park in the last top-level slot and re-insert when it cascades.
+    constexpr int top = SLOT_BITS * (LEVELS - 1);
+    link(index, (LEVELS - 1) * SLOTS + static_cast<int>(((currentTick >> top) + SLOTS - 1) & (SLOTS - 1)));
+}
+
+void TimerWheel::release(const std::uint32_t index) {
+    Node& node = nodes[index];
+    node.callback = nullptr;
+    node.list = FREE;
+    if (++node.generation == 0) node.generation = 1;
+    freeNodes.push_back(index);
+    pending--;
+}
+
+void TimerWheel::cascade(const int level, const int slot) {
+    List& source = lists[level * SLOTS + slot];
+    std::uint32_t index = source.head;
+    source = {};
+    occupied[level] &= ~(std::uint64_t{1} << slot);
+
+    while (index != NONE) {
+        const std::uint32_t next = nodes[index].next;
+        insert(index);
+        index = next;
+    }
+}
+
+void TimerWheel::advanceTo(const std::uint64_t tick) {
+    while (currentTick < tick) {
+        currentTick = std::min(nextEventTick(), tick);
+
+        if ((currentTick & (SLOTS - 1)) == 0) {
+            for (int level = 1; level < LEVELS; ++level) {
+                const int slot = static_cast<int>(currentTick >> SLOT_BITS * level & (SLOTS - 1));
+                cascade(level, slot);
+                if (slot != 0) break;
+            }
+        }
+
+        List& due = lists[currentTick & (SLOTS - 1)];
+        while (due.head != NONE) {
+            const std::uint32_t index = due.head;
+            unlink(index);
+            link(index, EXPIRED);
+        }
+    }
+}
+
+void TimerWheel::fireExpired(std::unique_lock<std::mutex>& lock) {
+    while (lists[EXPIRED].head != NONE) {
+        const std::uint32_t index = lists[EXPIRED].head;
+        unlink(index);
+
+        Node& node = nodes[index];
+        node.list = RUNNING;
+        running = index;
+
+        lock.unlock();
+        node.callback();
+        lock.lock();
+
+        running = NONE;
+        if (node.list == RUNNING && node.period > Clock::duration::zero()) {
+            node.deadline += node.period;
+            insert(index);
+        } else {
+            release(index);
+        }
+        idle.notify_all();
+    }
+}
+
+void TimerWheel::workerLoop() {
+    std::unique_lock lock(mutex);
+    while (!stopping) {
+        advanceTo(static_cast<std::uint64_t>(std::max(Clock::now() - epoch, Clock::duration::zero()) / resolution));
+        fireExpired(lock);
+        if (stopping || lists[EXPIRED].head != NONE) continue;
+
+        const std::uint64_t next = nextEventTick();
+        if (next == std::numeric_limits<std::uint64_t>::max())
+            wake.wait(lock);
+        else
+            wake.wait_until(lock, epoch + resolution * static_cast<Clock::rep>(next));
+    }
+}
+
+TimerWheel::TimerId TimerWheel::schedule(const Clock::time_point deadline, Callback callback,
+                                         const Clock::duration period) {
+    TimerId id;
+    {
+        std::lock_guard lock(mutex);
+        if (pending == 0)
+            currentTick = static_cast<std::uint64_t>(std::max(Clock::now() - epoch, Clock::duration::zero()) / resolution);
+
+        if (freeNodes.empty()) {
+            freeNodes.push_back(static_cast<std::uint32_t>(nodes.size()));
+            nodes.emplace_back();
+        }
+        const std::uint32_t index = freeNodes.back();
+        freeNodes.pop_back();
+
+        Node& node = nodes[index];
+        node.callback = std::move(callback);
+        node.deadline = deadline - epoch;
+        node.period = period;
+        insert(index);
+        pending++;
+        id = {index, node.generation};
+    }
+    wake.notify_one();
+    return id;
+}
+
+TimerWheel::TimerId TimerWheel::scheduleAfter(const Clock::duration delay, Callback callback,
+                                              const Clock::duration period) {
+    return schedule(Clock::now() + delay, std::move(callback), period);
+}
+
+bool TimerWheel::setPeriod(const TimerId id, const Clock::duration period) {
+    std::lock_guard lock(mutex);
+    Node* node = find(id);
+    if (!node) return false;
+
+    node->period = period;
+    return true;
+}
+
+bool TimerWheel::cancel(const TimerId id) {
+    std::lock_guard lock(mutex);
+    Node* node = find(id);
+    if (!node) return false;
+
+    if (node->list == RUNNING) {
+        node->list = CANCELLED;
+        if (++node->generation == 0) node->generation = 1;
+    } else {
+        unlink(id.index);
+        release(id.index);
+    }
+    return true;
+}
+
+bool TimerWheel::cancelAndWait(const TimerId id) {
+    const bool cancelled = cancel(id);
+    if (std::this_thread::get_id() == worker.get_id()) return cancelled;
+
+    std::unique_lock lock(mutex);
+    idle.wait(lock, [&] { return running != id.index; });
+    return cancelled;
+}
+
+size_t TimerWheel::getPendingCount() {
+    std::lock_guard lock(mutex);
+    return pending;
+}
+
+TimerWheel::Clock::duration TimerWheel::getResolution() const {
+    return resolution;
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Hierarchical timer wheel serviced by one thread: four levels of 64 slots, each slot an
+// intrusive list, so schedule and cancel are O(1) and far deadlines cascade down a level at a
+// time. The thread sleeps until the next occupied slot or cascade boundary and fires callbacks
+// without holding the wheel lock; a callback may schedule or cancel timers, including its own.
+// Deadlines fire within one resolution step. Large fleets can shard engines across a few wheels.
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+
+    struct TimerId {
+        std::uint32_t index = 0;
+        std::uint32_t generation = 0;
+
+        explicit operator bool() const { return generation != 0; }
+    };
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr int EXPIRED = LEVELS * SLOTS;
+    static constexpr int FREE = -1;
+    static constexpr int RUNNING = -2;
+    static constexpr int CANCELLED = -3;
+    static constexpr std::uint32_t NONE = ~0u;
+
+    struct Node {
+        Callback callback;
+        Clock::duration deadline{};
+        Clock::duration period{};
+        std::uint32_t prev = NONE;
+        std::uint32_t next = NONE;
+        std::uint32_t generation = 1;
+        int list = FREE;
+    };
+
+    struct List {
+        std::uint32_t head = NONE;
+        std::uint32_t tail = NONE;
+    };
+
+    Clock::time_point epoch;
+    Clock::duration resolution;
+
+    std::deque<Node> nodes;
+    std::vector<std::uint32_t> freeNodes;
+    std::array<List, EXPIRED + 1> lists{};
+    std::array<std::uint64_t, LEVELS> occupied{};
+    std::uint64_t currentTick = 0;
+    size_t pending = 0;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::uint32_t running = NONE;
+    bool stopping = false;
+    std::thread worker;
+
+    std::uint64_t tickAt(Clock::duration offset) const;
+    std::uint64_t nextEventTick() const;
+    Node* find(TimerId id);
+
+    void link(std::uint32_t index, int list);
+    void unlink(std::uint32_t index);
+    void insert(std::uint32_t index);
+    void release(std::uint32_t index);
+    void cascade(int level, int slot);
+    void advanceTo(std::uint64_t tick);
+    void fireExpired(std::unique_lock<std::mutex>& lock);
+    void workerLoop();
+
+public:
+    explicit TimerWheel(Clock::duration resolution = std::chrono::microseconds(250));
+    ~TimerWheel();
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // A non-zero period re-arms the timer at deadline + period after every firing, so it never
+    // drifts; a late wheel fires the missed periods back to back.
+    TimerId schedule(Clock::time_point deadline, Callback callback, Clock::duration period = {});
+    TimerId scheduleAfter(Clock::duration delay, Callback callback, Clock::duration period = {});
+
+    // Takes effect from the next re-arm; the deadline already pending is kept.
+    bool setPeriod(TimerId id, Clock::duration period);
+
+    // Returns false if the timer already fired or was cancelled. A callback that is executing at
+    // that moment still completes; cancelAndWait also waits for it unless called from the wheel
+    // thread itself.
+    bool cancel(TimerId id);
+    bool cancelAndWait(TimerId id);
+
+    size_t getPendingCount();
+    Clock::duration getResolution() const;
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Single-producer, single-consumer triple buffer. The writer fills its back buffer and publishes
+// it by swapping it with the middle slot; the reader swaps the middle slot into its front buffer
+// only when something new was published. Neither side ever waits for the other.
+template <typename T>
+class TripleBuffer {
+    static constexpr std::uint8_t INDEX_MASK = 0b011;
+    static constexpr std::uint8_t FRESH = 0b100;
+
+    std::array<T, 3> buffers{};
+    std::atomic<std::uint8_t> middle{1};
+    std::uint8_t back = 0;
+    std::uint8_t front = 2;
+
+public:
+    // Writer side.
+    T& writeBuffer() { return buffers[back]; }
+    int writeIndex() const { return back; }
+
+    void publish() {
+        back = middle.exchange(static_cast<std::uint8_t>(back | FRESH), std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Reader side. The returned buffer stays untouched until the reader's next call.
+    const T& read() {
+        if (middle.load(std::memory_order_relaxed) & FRESH)
+            front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        return buffers[front];
+    }
+};
@@ -7,14 +7,15 @@
 
 Renderer::Renderer()
     : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Tetris!"),
-      inputHandler(InputHandler::getInstance()),
-      scoreManager(ScoreManager::getInstance()),
-      gameEngine(GameEngine::getInstance(BOARD_WIDTH, BOARD_HEIGHT, inputHandler, scoreManager)),
+      gameEngine(BOARD_WIDTH, BOARD_HEIGHT, &leaderboard),
+      inputHandler(gameEngine.getInputHandler()),
+      scoreManager(gameEngine.getScoreManager()),
       currentScreen(ScreenState::MAIN_MENU),
       gameLoadedSuccessfully(false),
       gameSavedSuccessfully(false)
 {
     window.setFramerateLimit(FPS);
+    gameEngine.setDispatchMode(DispatchMode::QUEUED);
     loadFont();
     loadTextures();
 }
@@ -310,6 +311,7 @@ void Renderer::handleResize(const size_t width, const size_t height) {
 
 void Renderer::update() {
     handleContinuousInput();
+    gameEngine.processCommands();
 
     switch (currentScreen) {
         case ScreenState::PLAYING:
@@ -327,6 +329,7 @@ void Renderer::update() {
         case ScreenState::LOAD_GAME:
             if (!gameLoadedSuccessfully) {
                 inputHandler.handleKey(KeyType::LOAD);
+                gameEngine.processCommands();
                 if (gameEngine.getGameState() == GameState::LOADED) {
                     gameLoadedSuccessfully = true;
                 }
@@ -404,7 +407,7 @@ void Renderer::renderPlaying() {
     boardBox.setOutlineColor(sf::Color::White);
     boardBox.setOutlineThickness(1.f);
     window.draw(boardBox);
-    drawGrid(window, renderData.grid, boardPosition);
+    drawGrid(window, renderData, boardPosition);
 
     sf::Text nextText("NEXT", font, 24);
     nextText.setPosition(nextPosition.x, nextPosition.y - 40);
@@ -598,12 +601,12 @@ void Renderer::renderQuitting() {
     noBtn.draw(window);
 }
 
-void Renderer::drawGrid(sf::RenderTarget& target, const std::vector<std::vector<Cell>>& grid, sf::Vector2f position) const {
+void Renderer::drawGrid(sf::RenderTarget& target, const RenderData& renderData, sf::Vector2f position) const {
     sf::Sprite blockSprite(blockTexture);
 
-    for (size_t y = 0; y < grid.size(); ++y) {
-        for (size_t x = 0; x < grid[grid.size() - y - 1].size(); ++x) {
-            Cell cell = grid[grid.size() - y - 1][x];
+    for (int y = 0; y < renderData.height; ++y) {
+        for (int x = 0; x < renderData.width; ++x) {
+            Cell cell = renderData.at(x, renderData.height - y - 1);
 
             if (cell != Cell::Empty) {
                 sf::IntRect textureRect = textureMap.at(cell);
@@ -39,9 +39,10 @@ private:
     size_t windowWidth = 800;
     size_t windowHeight = 800;
 
+    Leaderboard leaderboard;
+    GameEngine gameEngine;
     InputHandler& inputHandler;
     ScoreManager& scoreManager;
-    GameEngine& gameEngine;
     std::atomic<bool> renderFlag{false};
 
     ScreenState currentScreen;
@@ -83,7 +84,7 @@ private:
 
     void loadFont();
     void loadTextures();
-    void drawGrid(sf::RenderTarget& target, const std::vector<std::vector<Cell>>& grid, sf::Vector2f position) const;
+    void drawGrid(sf::RenderTarget& target, const RenderData& renderData, sf::Vector2f position) const;
     static void centerText(sf::Text& text, sf::Vector2f centerPos);
     static void centerTextInRect(sf::Text& text, sf::FloatRect rect);
 };
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "InputPolicy.h"
+#include <array>
+
+static constexpr std::array<KeyType, 7> RANDOM_KEYS = {
+    KeyType::LEFT, KeyType::RIGHT, KeyType::ROTATE_CW, KeyType::ROTATE_CCW,
+    KeyType::SOFT_DROP, KeyType::HARD_DROP, KeyType::HOLD
+};
+
+RandomPolicy::RandomPolicy(const std::uint64_t seed, const std::uint32_t actionsPerHundredFrames)
+    : rng(seed), actionsPerHundredFrames(actionsPerHundredFrames) {}
+
+KeyType RandomPolicy::nextInput(GameEngine&) {
+    if (uniformBelow(rng, 100) >= actionsPerHundredFrames) return KeyType::NONE;
+    return RANDOM_KEYS[uniformBelow(rng, RANDOM_KEYS.size())];
+}
+
+ScriptedPolicy::ScriptedPolicy(std::vector<KeyType> script) : script(std::move(script)) {}
+
+std::vector<KeyType> ScriptedPolicy::parse(const std::string& text) {
+    std::vector<KeyType> keys;
+    keys.reserve(text.size());
+
+    for (const char c : text) {
+        switch (c) {
+            case 'L': keys.push_back(KeyType::LEFT); break;
+            case 'R': keys.push_back(KeyType::RIGHT); break;
+            case 'C': keys.push_back(KeyType::ROTATE_CW); break;
+            case 'A': keys.push_back(KeyType::ROTATE_CCW); break;
+            case 'S': keys.push_back(KeyType::SOFT_DROP); break;
+            case 'D': keys.push_back(KeyType::HARD_DROP); break;
+            case 'H': keys.push_back(KeyType::HOLD); break;
+            case '.': keys.push_back(KeyType::NONE); break;
+            default: break;
+        }
+    }
+    return keys;
+}
+
+KeyType ScriptedPolicy::nextInput(GameEngine&) {
+    if (script.empty()) return KeyType::NONE;
+
+    const KeyType key = script[cursor];
+    cursor = (cursor + 1) % script.size();
+    return key;
+}
+
+BotPolicy::BotPolicy(const BotConfig config) : bot(config) {}
+
+KeyType BotPolicy::nextInput(GameEngine& engine) {
+    const int piece = engine.getPiecesPlaced();
+    if (piece != plannedPiece) {
+        plannedPiece = piece;
+        if (bot.play(engine) && engine.getPiecesPlaced() != piece + 1)
+            missedPlacements++;
+    }
+    return KeyType::NONE;
+}
+
+int BotPolicy::getMissedPlacements() const {
+    return missedPlacements;
+}
+
+SearchPolicy::SearchPolicy(const SearchConfig config) : search(config) {}
+
+KeyType SearchPolicy::nextInput(GameEngine& engine) {
+    const int piece = engine.getPiecesPlaced();
+    if (piece != plannedPiece) {
+        plannedPiece = piece;
+        if (search.play(engine) && engine.getPiecesPlaced() != piece + 1)
+            missedPlacements++;
+    }
+    return KeyType::NONE;
+}
+
+int SearchPolicy::getMissedPlacements() const {
+    return missedPlacements;
+}
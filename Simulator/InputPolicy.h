@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GameEngine/GameEngine.h"
+#include "GameEngine/BlockFactory/Pcg32.h"
+#include "GameEngine/Bot/Bot.h"
+#include "GameEngine/Bot/ParallelSearch.h"
+
+class InputPolicy {
+public:
+    virtual ~InputPolicy() = default;
+
+    virtual KeyType nextInput(GameEngine& engine) = 0;
+    // Planned placements that did not lock exactly one piece. Always 0 for key-level policies.
+    virtual int getMissedPlacements() const { return 0; }
+};
+
+using PolicyFactory = std::function<std::unique_ptr<InputPolicy>(std::uint64_t seed)>;
+
+class RandomPolicy final : public InputPolicy {
+    Pcg32 rng;
+    std::uint32_t actionsPerHundredFrames;
+
+public:
+    explicit RandomPolicy(std::uint64_t seed, std::uint32_t actionsPerHundredFrames = 25);
+
+    KeyType nextInput(GameEngine& engine) override;
+};
+
+class ScriptedPolicy final : public InputPolicy {
+    std::vector<KeyType> script;
+    size_t cursor = 0;
+
+public:
+    explicit ScriptedPolicy(std::vector<KeyType> script);
+
+    static std::vector<KeyType> parse(const std::string& text);
+
+    KeyType nextInput(GameEngine& engine) override;
+};
+
+// Plans and plays a whole piece through the engine API on the first frame it is in play.
+class BotPolicy final : public InputPolicy {
+    Bot bot;
+    int plannedPiece = -1;
+    int missedPlacements = 0;
+
+public:
+    explicit BotPolicy(BotConfig config = {});
+
+    KeyType nextInput(GameEngine& engine) override;
+    int getMissedPlacements() const override;
+};
+
+class SearchPolicy final : public InputPolicy {
+    ParallelSearch search;
+    int plannedPiece = -1;
+    int missedPlacements = 0;
+
+public:
+    explicit SearchPolicy(SearchConfig config = {});
+
+    KeyType nextInput(GameEngine& engine) override;
+    int getMissedPlacements() const override;
+};
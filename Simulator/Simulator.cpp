@@ -0,0 +1,132 @@
+#include "Simulator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+Simulator::Simulator(SimulationConfig config) : config(std::move(config)) {
+    if (this->config.threads <= 0)
+        this->config.threads = std::max(1u, std::thread::hardware_concurrency());
+}
+
+GameResult Simulator::playGame(const int index) const {
+    GameEngine engine(config.boardWidth, config.boardHeight);
+    engine.seed(BagGenerator::deriveSeed(config.seed, index), index);
+    engine.setClockMode(ClockMode::FIXED_STEP);
+    if (config.verifyReplays) engine.startRecording();
+    engine.startNewGame(config.startLevel);
+
+    const auto policy = config.policyFactory(BagGenerator::deriveSeed(~config.seed, index));
+    InputHandler& input = engine.getInputHandler();
+
+    GameResult result;
+    while (engine.getGameState() == GameState::RUNNING &&
+           result.frames < config.maxFrames &&
+           engine.getPiecesPlaced() < config.maxPieces) {
+        const KeyType key = policy->nextInput(engine);
+        if (key != KeyType::NONE)
+            input.handleKey(key);
+
+        engine.advanceFrames(1);
+        result.frames++;
+    }
+
+    const ScoreManager& scoreManager = engine.getScoreManager();
+    result.score = scoreManager.getScore();
+    result.linesCleared = scoreManager.getTotalLinesCleared();
+    result.piecesPlaced = engine.getPiecesPlaced();
+    result.toppedOut = engine.getGameState() == GameState::GAME_OVER;
+    result.missedPlacements = policy->getMissedPlacements();
+
+    if (config.verifyReplays) {
+        const Replay replay = engine.stopRecording();
+        GameEngine playback(config.boardWidth, config.boardHeight);
+        result.replayVerified = playback.playReplay(replay) == replay.outcome;
+        result.replayBytes = replay.events.size();
+    }
+    return result;
+}
+
+SimulationReport Simulator::run() const {
+    SimulationReport report;
+    report.games.resize(config.games);
+    report.threads = std::min(config.threads, std::max(config.games, 1));
+    report.replaysChecked = config.verifyReplays;
+
+    std::atomic<int> nextGame{0};
+    const auto worker = [&] {
+        for (int index = nextGame++; index < config.games; index = nextGame++)
+            report.games[index] = playGame(index);
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    workers.reserve(report.threads);
+    for (int i = 0; i < report.threads; ++i)
+        workers.emplace_back(worker);
+    for (auto& thread : workers)
+        thread.join();
+    report.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return report;
+}
+
+static long long percentile(const std::vector<long long>& sorted, const double fraction) {
+    if (sorted.empty()) return 0;
+    const auto index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+void printReport(const SimulationReport& report, std::ostream& out) {
+    std::vector<long long> scores;
+    scores.reserve(report.games.size());
+    long long totalPieces = 0, totalFrames = 0, totalLines = 0, totalScore = 0;
+    int toppedOut = 0, replaysVerified = 0;
+    size_t replayBytes = 0;
+
+    for (const auto& game : report.games) {
+        scores.push_back(game.score);
+        totalPieces += game.piecesPlaced;
+        totalFrames += game.frames;
+        totalLines += game.linesCleared;
+        totalScore += game.score;
+        toppedOut += game.toppedOut ? 1 : 0;
+        replaysVerified += game.replayVerified ? 1 : 0;
+        replayBytes += game.replayBytes;
+    }
+    std::sort(scores.begin(), scores.end());
+
+    const double seconds = std::max(report.wallSeconds, 1e-9);
+    const auto games = static_cast<double>(std::max<size_t>(report.games.size(), 1));
+
+    out << std::fixed << std::setprecision(1);
+    out << "games:        " << report.games.size() << " on " << report.threads << " threads in "
+        << std::setprecision(3) << report.wallSeconds << " s\n" << std::setprecision(1);
+    out << "throughput:   " << static_cast<double>(report.games.size()) / seconds << " games/s, "
+        << static_cast<double>(totalPieces) / seconds << " pieces/s, "
+        << static_cast<double>(totalFrames) / seconds << " frames/s\n";
+    out << "pieces/game:  " << static_cast<double>(totalPieces) / games
+        << "  lines/game: " << static_cast<double>(totalLines) / games
+        << "  topped out: " << toppedOut << "\n";
+    out << "score:        mean " << static_cast<double>(totalScore) / games
+        << "  min " << (scores.empty() ? 0 : scores.front())
+        << "  p50 " << percentile(scores, 0.5)
+        << "  p90 " << percentile(scores, 0.9)
+        << "  p99 " << percentile(scores, 0.99)
+        << "  max " << (scores.empty() ? 0 : scores.back()) << "\n";
+    if (const int missed = countMissedPlacements(report))
+        out << "missed:       " << missed << " bot plays did not place exactly one piece\n";
+    if (report.replaysChecked) {
+        out << "replays:      " << replaysVerified << " verified, "
+            << static_cast<int>(report.games.size()) - replaysVerified << " mismatched, "
+            << static_cast<double>(replayBytes) / games << " bytes/game\n";
+    }
+}
+
+int countMissedPlacements(const SimulationReport& report) {
+    int missed = 0;
+    for (const auto& game : report.games)
+        missed += game.missedPlacements;
+    return missed;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "InputPolicy.h"
+
+struct SimulationConfig {
+    int games = 100;
+    int threads = 0;
+    std::uint64_t seed = 1;
+    int startLevel = 1;
+    int maxPieces = 1000;
+    long long maxFrames = 60LL * 60 * 60;
+    int boardWidth = 10;
+    int boardHeight = 20;
+    // Records every game and replays it on a fresh engine to check it ends the same way.
+    bool verifyReplays = false;
+    PolicyFactory policyFactory;
+};
+
+struct GameResult {
+    long long score = 0;
+    int linesCleared = 0;
+    int piecesPlaced = 0;
+    long long frames = 0;
+    bool toppedOut = false;
+    int missedPlacements = 0;
+    bool replayVerified = false;
+    size_t replayBytes = 0;
+};
+
+struct SimulationReport {
+    std::vector<GameResult> games;
+    int threads = 0;
+    double wallSeconds = 0.0;
+    bool replaysChecked = false;
+};
+
+class Simulator {
+    SimulationConfig config;
+
+    GameResult playGame(int index) const;
+public:
+    explicit Simulator(SimulationConfig config);
+
+    SimulationReport run() const;
+};
+
+void printReport(const SimulationReport& report, std::ostream& out);
+// Bot plays that did not place exactly one piece, summed over every game.
+int countMissedPlacements(const SimulationReport& report);
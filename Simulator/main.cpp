@@ -0,0 +1,69 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "Simulator.h"
+
+static void printUsage(const char* program) {
+    std::cerr << "usage: " << program
+              << " [--games N] [--threads N] [--seed N] [--level N] [--max-pieces N]"
+                 " [--policy random|scripted|bot|search] [--script KEYS] [--beam N] [--depth N]"
+                 " [--search-threads N] [--verify-replays]\n"
+                 "  script keys: L R C(cw) A(ccw) S(soft) D(hard) H(hold) .(idle)\n";
+}
+
+int main(const int argc, char** argv) {
+    SimulationConfig config;
+    std::string policy = "random";
+    std::string script = "LLCD....RRRD....AD....LD....RRD...";
+    BotConfig botConfig;
+    SearchConfig searchConfig;
+
+    for (int i = 1; i < argc; ++i) {
+        const auto hasValue = [&] { return i + 1 < argc; };
+        if (std::strcmp(argv[i], "--games") == 0 && hasValue()) config.games = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--threads") == 0 && hasValue()) config.threads = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue()) config.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--level") == 0 && hasValue()) config.startLevel = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--max-pieces") == 0 && hasValue()) config.maxPieces = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--policy") == 0 && hasValue()) policy = argv[++i];
+        else if (std::strcmp(argv[i], "--script") == 0 && hasValue()) script = argv[++i];
+        else if (std::strcmp(argv[i], "--beam") == 0 && hasValue()) botConfig.beamWidth = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--depth") == 0 && hasValue())
+            botConfig.previewDepth = searchConfig.previewDepth = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--search-threads") == 0 && hasValue()) searchConfig.threads = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--verify-replays") == 0) config.verifyReplays = true;
+        else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (policy == "random") {
+        config.policyFactory = [](const std::uint64_t seed) -> std::unique_ptr<InputPolicy> {
+            return std::make_unique<RandomPolicy>(seed);
+        };
+    } else if (policy == "scripted") {
+        const auto keys = ScriptedPolicy::parse(script);
+        config.policyFactory = [keys](std::uint64_t) -> std::unique_ptr<InputPolicy> {
+            return std::make_unique<ScriptedPolicy>(keys);
+        };
+    } else if (policy == "bot") {
+        config.policyFactory = [botConfig](std::uint64_t) -> std::unique_ptr<InputPolicy> {
+            return std::make_unique<BotPolicy>(botConfig);
+        };
+    } else if (policy == "search") {
+        config.policyFactory = [searchConfig](std::uint64_t) -> std::unique_ptr<InputPolicy> {
+            return std::make_unique<SearchPolicy>(searchConfig);
+        };
+    } else {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    const Simulator simulator(config);
+    const SimulationReport report = simulator.run();
+    printReport(report, std::cout);
+    return countMissedPlacements(report) == 0 ? 0 : 2;
+}
@@ -0,0 +1,330 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "GameEngine/GameEngine.h"
+#include "GameEngine/Replay/Replay.h"
+#include "GameEngine/Search/MoveGenerator.h"
+#include "GameEngine/Search/PerfectClearSolver.h"
+#include "GameEngine/SnapshotManagement/CheckpointLog.h"
+#include "GameEngine/SnapshotManagement/SnapshotCodec.h"
+#include "GameEngine/TimerWheel.h"
+
+// Minimal self-contained harness: each test reports failed checks and keeps going, and the
+// process exits non-zero if any check failed. Pass test names on the command line to run a subset.
+namespace {
+    int failedChecks = 0;
+
+#define CHECK(condition)                                                                \
+    do {                                                                                \
+        if (!(condition)) {                                                             \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++failedChecks;                                                             \
+        }                                                                               \
+    } while (false)
+
+    bool sameSnapshot(const Snapshot& a, const Snapshot& b) {
+        return a.grid == b.grid && a.score == b.score && a.level == b.level &&
+               a.totalLinesCleared == b.totalLinesCleared && a.currentBlockType == b.currentBlockType &&
+               a.currentBlockPosition.x == b.currentBlockPosition.x &&
+               a.currentBlockPosition.y == b.currentBlockPosition.y &&
+               a.currentBlockRotation == b.currentBlockRotation && a.holdBlockType == b.holdBlockType &&
+               a.bag == b.bag;
+    }
+
+    // A few pieces into a seeded game, so the board, hold slot and bag are all non-trivial.
+    void playOpening(GameEngine& engine) {
+        engine.startNewGame(1);
+        for (int i = 0; i < 6; ++i) {
+            engine.requestMove(i % 3 - 1);
+            if (i == 2) engine.requestHold();
+            engine.requestRotate(i % 3 == 0);
+            engine.advanceFrames(5);
+            engine.requestHardDrop();
+        }
+    }
+
+    void snapshotCodec() {
+        GameEngine engine;
+        engine.setClockMode(ClockMode::FIXED_STEP);
+        engine.seed(42);
+        playOpening(engine);
+        const Snapshot snapshot = engine.createSnapshot();
+        CHECK(snapshot.holdBlockType != Cell::Empty);
+        CHECK(snapshot.grid[0] != std::vector<Cell>(10, Cell::Empty));
+
+        std::vector<std::uint8_t> encoded;
+        encodeSnapshot(snapshot, encoded);
+        CHECK(encoded.size() <= maxEncodedSnapshotSize(10, 20));
+        CHECK(isBinarySnapshot(encoded.data(), encoded.size()));
+
+        Snapshot decoded;
+        CHECK(decodeSnapshot(encoded.data(), encoded.size(), decoded));
+        CHECK(sameSnapshot(snapshot, decoded));
+
+        for (size_t i = 0; i < encoded.size(); ++i) {
+            std::vector<std::uint8_t> corrupted = encoded;
+            corrupted[i] ^= 0x10;
+            CHECK(!decodeSnapshot(corrupted.data(), corrupted.size(), decoded));
+        }
+        for (size_t size = 0; size < encoded.size(); ++size)
+            CHECK(!decodeSnapshot(encoded.data(), size, decoded));
+
+        // Well-formed and correctly checksummed, but describing an impossible game.
+        Snapshot offBoard = snapshot;
+        offBoard.currentBlockPosition = {40, 3};
+        CHECK(!isValidSnapshot(offBoard));
+        encodeSnapshot(offBoard, encoded);
+        CHECK(!decodeSnapshot(encoded.data(), encoded.size(), decoded));
+
+        Snapshot ghostPiece = snapshot;
+        ghostPiece.holdBlockType = Cell::GhostT;
+        CHECK(!isValidSnapshot(ghostPiece));
+        encodeSnapshot(ghostPiece, encoded);
+        CHECK(!decodeSnapshot(encoded.data(), encoded.size(), decoded));
+    }
+
+    void replayCodec() {
+        GameEngine engine;
+        engine.setClockMode(ClockMode::FIXED_STEP);
+        engine.seed(7, 3);
+        engine.startRecording();
+        playOpening(engine);
+        const Replay replay = engine.stopRecording();
+        CHECK(replay.eventCount > 0);
+
+        std::vector<std::uint8_t> encoded;
+        encodeReplay(replay, encoded);
+        Replay decoded;
+        CHECK(decodeReplay(encoded.data(), encoded.size(), decoded));
+        CHECK(decoded.boardWidth == replay.boardWidth && decoded.boardHeight == replay.boardHeight);
+        CHECK(decoded.seed == replay.seed && decoded.stream == replay.stream);
+        CHECK(decoded.rngEngine == replay.rngEngine);
+        CHECK(decoded.eventCount == replay.eventCount && decoded.events == replay.events);
+        CHECK(decoded.outcome == replay.outcome);
+
+        ReplayReader original(replay);
+        ReplayReader roundTripped(decoded);
+        ReplayEvent a{};
+        ReplayEvent b{};
+        std::uint32_t events = 0;
+        while (original.next(a)) {
+            CHECK(roundTripped.next(b));
+            CHECK(a.type == b.type && a.argument == b.argument && a.time == b.time);
+            ++events;
+        }
+        CHECK(!roundTripped.next(b));
+        CHECK(events == replay.eventCount);
+
+        GameEngine player;
+        CHECK(player.playReplay(decoded) == replay.outcome);
+
+        for (size_t i = 0; i < encoded.size(); ++i) {
+            std::vector<std::uint8_t> corrupted = encoded;
+            corrupted[i] ^= 0x01;
+            CHECK(!decodeReplay(corrupted.data(), corrupted.size(), decoded));
+        }
+        for (size_t size = 0; size < encoded.size(); ++size)
+            CHECK(!decodeReplay(encoded.data(), size, decoded));
+    }
+
+    void moveGenerator() {
+        MoveGenerator generator;
+        const Position spawn{4, 18};
+
+        // Distinct resting cell sets on an empty 10-wide board.
+        const BitBoard empty(10, 20);
+        CHECK(generator.generate(empty, Block(Cell::I, spawn)).size() == 17);
+        CHECK(generator.generate(empty, Block(Cell::O, spawn)).size() == 9);
+        CHECK(generator.generate(empty, Block(Cell::T, spawn)).size() == 34);
+        CHECK(generator.generate(empty, Block(Cell::S, spawn)).size() == 17);
+        CHECK(generator.generate(empty, Block(Cell::Z, spawn)).size() == 17);
+        CHECK(generator.generate(empty, Block(Cell::J, spawn)).size() == 34);
+        CHECK(generator.generate(empty, Block(Cell::L, spawn)).size() == 34);
+
+        // T-spin double slot under an overhang at (3, 2).
+        BitBoard slot(10, 20);
+        slot.setRow(0, slot.getFullRowMask() & ~(RowMask{1} << 4));
+        slot.setRow(1, slot.getFullRowMask() & ~(RowMask{7} << 3));
+        slot.setCell(3, 2);
+        CHECK(generator.generate(slot, Block(Cell::I, spawn)).size() == 17);
+        CHECK(generator.generate(slot, Block(Cell::O, spawn)).size() == 9);
+        CHECK(generator.generate(slot, Block(Cell::S, spawn)).size() == 18);
+
+        const auto& placements = generator.generate(slot, Block(Cell::T, spawn));
+        CHECK(placements.size() == 37);
+        bool foundSpin = false;
+        for (const auto& placement : placements) {
+            if (placement.block.getRotation() != Rotation::R180) continue;
+            const Position position = placement.block.getPosition();
+            if (position.x != 4 || position.y != 1) continue;
+            foundSpin = true;
+
+            BitBoard after = slot;
+            after.place(placement.block.getShapeMask(), position);
+            CHECK(countCells(after.clearFullLines()) == 2);
+            CHECK(!generator.pathTo(placement).empty());
+        }
+        CHECK(foundSpin);
+    }
+
+    template <typename Predicate>
+    bool waitFor(Predicate predicate) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!predicate()) {
+            if (std::chrono::steady_clock::now() > deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    void timerWheel() {
+        using namespace std::chrono_literals;
+        TimerWheel wheel(1ms);
+
+        std::atomic<int> cancelledFired{0};
+        const auto cancelled = wheel.scheduleAfter(20ms, [&] { ++cancelledFired; });
+        CHECK(wheel.getPendingCount() == 1);
+        CHECK(wheel.cancel(cancelled));
+        CHECK(!wheel.cancel(cancelled));
+        CHECK(wheel.getPendingCount() == 0);
+
+        // The freed node is reused; the stale id must not cancel its new owner.
+        std::atomic<int> rearmedFired{0};
+        const auto rearmed = wheel.scheduleAfter(10ms, [&] { ++rearmedFired; });
+        CHECK(!wheel.cancel(cancelled));
+        CHECK(waitFor([&] { return rearmedFired == 1; }));
+        CHECK(!wheel.cancel(rearmed));
+
+        std::atomic<int> ticks{0};
+        const auto periodic = wheel.scheduleAfter(2ms, [&] { ++ticks; }, 2ms);
+        CHECK(waitFor([&] { return ticks >= 3; }));
+        CHECK(wheel.setPeriod(periodic, 1ms));
+        const int before = ticks;
+        CHECK(waitFor([&] { return ticks >= before + 3; }));
+        CHECK(wheel.cancelAndWait(periodic));
+        const int stopped = ticks;
+        std::this_thread::sleep_for(30ms);
+        CHECK(ticks == stopped);
+        CHECK(cancelledFired == 0);
+        CHECK(wheel.getPendingCount() == 0);
+    }
+
+    void checkpointLog() {
+        GameEngine engine;
+        engine.setClockMode(ClockMode::FIXED_STEP);
+        engine.seed(11);
+        engine.startNewGame(1);
+
+        CheckpointLog log(10, 20, 4);
+        std::vector<Snapshot> history;
+        for (int i = 0; i < 13; ++i) {
+            history.push_back(engine.createSnapshot());
+            log.append(history.back());
+            engine.requestMove(i % 5 - 2);
+            if (i % 4 == 1) engine.requestHold();
+            engine.requestHardDrop();
+        }
+        CHECK(log.size() == history.size());
+
+        // Indices 0, 4, 8 and 12 are keyframes; the rest replay deltas from the one before them.
+        Snapshot scratch;
+        for (size_t i = 0; i < history.size(); ++i) {
+            CHECK(sameSnapshot(log.get(i), history[i]));
+            log.get(i, scratch);
+            CHECK(sameSnapshot(scratch, history[i]));
+        }
+        for (size_t i = history.size(); i-- > 0;) {
+            log.get(i, scratch);
+            CHECK(sameSnapshot(scratch, history[i]));
+        }
+
+        // Appending after a truncate deltas against the new last checkpoint.
+        log.truncate(6);
+        history.resize(6);
+        Snapshot branch = history.back();
+        branch.score += 1000;
+        branch.grid[0].assign(10, Cell::J);
+        branch.grid[0][3] = Cell::Empty;
+        branch.bag.erase(branch.bag.begin());
+        history.push_back(branch);
+        log.append(branch);
+        CHECK(log.size() == 7);
+        for (size_t i = 0; i < history.size(); ++i)
+            CHECK(sameSnapshot(log.get(i), history[i]));
+
+        log.clear();
+        CHECK(log.empty());
+        CHECK(log.getMemoryUsage() == 0);
+    }
+
+    // A board that is only solvable by clearing the bottom row first, which joins the empty cell at
+    // (0, 0) to the column above it. Region pruning that ignored line clears rejected it outright.
+    void perfectClear() {
+        Snapshot snapshot{};
+        snapshot.grid.assign(20, std::vector<Cell>(10, Cell::Empty));
+        for (int x = 1; x < 10; ++x)
+            snapshot.grid[0][x] = Cell::Z;
+        snapshot.grid[1][0] = snapshot.grid[1][1] = snapshot.grid[2][1] = Cell::Z;
+        snapshot.level = 1;
+        snapshot.currentBlockType = Cell::I;
+        snapshot.currentBlockPosition = {4, 18};
+        snapshot.currentBlockRotation = Rotation::R0;
+        snapshot.holdBlockType = Cell::Empty;
+        snapshot.bag = {Cell::I, Cell::J, Cell::O, Cell::O, Cell::O, Cell::O};
+
+        PerfectClearSolver solver({10, 1});
+        const PerfectClearResult result = solver.solve(snapshot);
+        CHECK(result.found);
+
+        BitBoard board(10, 20);
+        for (int y = 0; y < 20; ++y) {
+            for (int x = 0; x < 10; ++x) {
+                if (snapshot.grid[y][x] != Cell::Empty) board.setCell(x, y);
+            }
+        }
+        for (const auto& step : result.steps) {
+            CHECK(board.fits(step.block.getShapeMask(), step.block.getPosition()));
+            board.place(step.block.getShapeMask(), step.block.getPosition());
+            board.clearFullLines();
+        }
+        CHECK(!result.steps.empty() && board.getStackHeight() == 0);
+
+        // One O piece cannot clear the same board.
+        snapshot.currentBlockType = Cell::O;
+        snapshot.bag.clear();
+        CHECK(!solver.solve(snapshot).found);
+    }
+
+    struct Test {
+        const char* name;
+        void (*run)();
+    };
+
+    const Test TESTS[] = {
+        {"snapshot_codec", snapshotCodec},
+        {"replay_codec", replayCodec},
+        {"move_generator", moveGenerator},
+        {"timer_wheel", timerWheel},
+        {"checkpoint_log", checkpointLog},
+        {"perfect_clear", perfectClear},
+    };
+}
+
+int main(const int argc, char* argv[]) {
+    for (const Test& test : TESTS) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; ++i)
+            selected |= std::strcmp(argv[i], test.name) == 0;
+        if (!selected) continue;
+
+        const int before = failedChecks;
+        test.run();
+        std::printf("%s %s\n", failedChecks == before ? "PASS" : "FAIL", test.name);
+    }
+    return failedChecks == 0 ? 0 : 1;
+}